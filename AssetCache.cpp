@@ -0,0 +1,104 @@
+//  Copyright 2025 <Orbosa Igbinovia> [legal/copyright]
+#include "AssetCache.hpp"
+#include <chrono>
+#include <iostream>
+
+namespace SB {
+
+namespace {
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+}
+}  // namespace
+
+AssetCache& AssetCache::instance() {
+    static AssetCache cache;
+    return cache;
+}
+
+const sf::Image* AssetCache::image(const std::string& filename) {
+    std::lock_guard<std::mutex> guard(lock);
+    return loadImage(filename);
+}
+
+// Caller holds the lock
+const sf::Image* AssetCache::loadImage(const std::string& filename) {
+    auto found = images.find(filename);
+    if (found != images.end()) {
+        ++counters.cacheHits;
+        return found->second.get();
+    }
+    auto start = std::chrono::steady_clock::now();
+    auto image = std::make_unique<sf::Image>();
+    if (!image->loadFromFile(filename)) {
+        std::cerr << "Failed to load image from file: " << filename
+                  << std::endl;
+        ++counters.failures;
+        image.reset();  // remember the failure so we do not retry
+    } else {
+        ++counters.imagesDecoded;
+    }
+    counters.loadSeconds += secondsSince(start);
+    return images.emplace(filename, std::move(image)).first->second.get();
+}
+
+const sf::Font* AssetCache::font(const std::string& filename) {
+    std::lock_guard<std::mutex> guard(lock);
+    auto found = fonts.find(filename);
+    if (found != fonts.end()) {
+        ++counters.cacheHits;
+        return found->second.get();
+    }
+    auto start = std::chrono::steady_clock::now();
+    auto font = std::make_unique<sf::Font>();
+    if (!font->loadFromFile(filename)) {
+        ++counters.failures;
+        font.reset();
+    } else {
+        ++counters.fontsLoaded;
+    }
+    counters.loadSeconds += secondsSince(start);
+    return fonts.emplace(filename, std::move(font)).first->second.get();
+}
+
+const sf::Texture& AssetCache::atlas(const std::vector<std::string>& tiles,
+ unsigned int tileSize) {
+    std::lock_guard<std::mutex> guard(lock);
+    std::string key = std::to_string(tileSize);
+    for (const std::string& tile : tiles) {
+        key += '|' + tile;
+    }
+    auto found = atlases.find(key);
+    if (found != atlases.end()) {
+        ++counters.cacheHits;
+        return *found->second;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    sf::Image sheet;
+    sheet.create(tileSize * static_cast<unsigned int>(tiles.size()), tileSize,
+        sf::Color::Transparent);
+    for (std::size_t slot = 0; slot < tiles.size(); ++slot) {
+        const sf::Image* tile = loadImage(tiles[slot]);
+        if (tile == nullptr) continue;
+        if (tile->getSize() != sf::Vector2u(tileSize, tileSize)) {
+            std::cerr << "Tile image " << tiles[slot] << " is not "
+                      << tileSize << "x" << tileSize << std::endl;
+            continue;
+        }
+        sheet.copy(*tile, static_cast<unsigned int>(slot) * tileSize, 0);
+    }
+    auto texture = std::make_unique<sf::Texture>();
+    texture->loadFromImage(sheet);
+    ++counters.atlasesBuilt;
+    counters.loadSeconds += secondsSince(start);
+    return *atlases.emplace(key, std::move(texture)).first->second;
+}
+
+AssetStats AssetCache::stats() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return counters;
+}
+
+}  // namespace SB
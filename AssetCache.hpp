@@ -0,0 +1,49 @@
+//  Copyright 2025 <Orbosa Igbinovia> [legal/copyright]
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+namespace SB {
+
+struct AssetStats {
+    std::size_t imagesDecoded = 0;
+    std::size_t fontsLoaded = 0;
+    std::size_t atlasesBuilt = 0;
+    std::size_t cacheHits = 0;
+    std::size_t failures = 0;
+    double loadSeconds = 0.0;  //  time spent reading and uploading
+};
+
+//  Process-wide store for everything read from disk. Each file is decoded
+//  at most once and each atlas uploaded at most once, no matter how many
+//  Sokoban objects ask for it. Returned pointers stay valid for the life
+//  of the process.
+class AssetCache {
+ public:
+    static AssetCache& instance();
+
+    //  nullptr when the file cannot be read
+    const sf::Image* image(const std::string& filename);
+    const sf::Font* font(const std::string& filename);
+    //  Tiles side by side, in the given order, each tileSize square
+    const sf::Texture& atlas(const std::vector<std::string>& tiles,
+        unsigned int tileSize);
+    AssetStats stats() const;
+
+ private:
+    AssetCache() = default;
+    const sf::Image* loadImage(const std::string& filename);
+
+    mutable std::mutex lock;
+    std::unordered_map<std::string, std::unique_ptr<sf::Image>> images;
+    std::unordered_map<std::string, std::unique_ptr<sf::Font>> fonts;
+    std::unordered_map<std::string, std::unique_ptr<sf::Texture>> atlases;
+    AssetStats counters;
+};
+
+}  // namespace SB
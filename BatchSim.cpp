@@ -0,0 +1,231 @@
+//  Copyright 2025 <Orbosa Igbinovia> [legal/copyright]
+#include "BatchSim.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include "Deadlock.hpp"
+#include "FixedBoard.hpp"
+#include "ThreadPool.hpp"
+
+namespace SB {
+
+namespace {
+void set(std::vector<uint64_t>& bits, std::size_t square) {
+    bits[square >> 6] |= uint64_t{1} << (square & 63);
+}
+
+// Plays one sequence on a by-value copy of a fixed-size board
+template <class Fixed>
+PlayoutResult playFixed(Fixed board, const std::vector<Direction>& seq) {
+    PlayoutResult r;
+    r.won = board.isWon();
+    r.length = r.won ? 0 : seq.size();
+    for (std::size_t t = 0; t < seq.size() && !r.won; ++t) {
+        r.blocked += !board.move(seq[t]);
+        if (board.isWon()) {
+            r.won = true;
+            r.length = t + 1;
+        }
+    }
+    r.lost = board.lost();
+    r.moves = board.moves();
+    r.pushes = board.pushes();
+    r.boxesOnGoals = board.boxesOnGoals();
+    return r;
+}
+
+template <class Fixed>
+std::vector<PlayoutResult> fixedPlayouts(const Board& level,
+ const std::vector<std::vector<Direction>>& sequences, unsigned int threads,
+ std::size_t batchSize) {
+    std::vector<PlayoutResult> results(sequences.size());
+    const Fixed start(level);
+    ThreadPool pool(threads);
+    for (std::size_t first = 0; first < sequences.size();
+     first += batchSize) {
+        pool.submit([&, first] {
+            std::size_t last = std::min(first + batchSize, sequences.size());
+            for (std::size_t j = first; j < last; ++j) {
+                results[j] = playFixed(start, sequences[j]);
+            }
+        });
+    }
+    pool.wait();
+    return results;
+}
+}  // namespace
+
+BatchSim::BatchSim(const Board& level, std::size_t count)
+    : start(level), words((level.size() + 63) / 64),
+      walls(words, 0), goals(words, 0), dead(words, 0),
+      startBoxes(words, 0) {
+    const Direction all[4] = {Direction::Up, Direction::Down,
+        Direction::Left, Direction::Right};
+    for (Direction dir : all) {
+        offsets[static_cast<uint8_t>(dir)] =
+            static_cast<int32_t>(level.step(dir));
+    }
+    bool hasPlayer = false;
+    for (std::size_t i = 0; i < level.size(); ++i) {
+        if (level.isWall(i)) set(walls, i);
+        if (level.isGoal(i)) {
+            set(goals, i);
+            ++goalCount;
+        }
+        if (level.hasBox(i)) {
+            set(startBoxes, i);
+            ++boxCount;
+            startOnGoals += level.isGoal(i);
+        }
+        if (level.piece(i) == Board::Player) {
+            startPlayer = static_cast<uint32_t>(i);
+            hasPlayer = true;
+        }
+    }
+    if (!hasPlayer) {
+        throw std::invalid_argument("level has no player");
+    }
+    Deadlock analysis(level);
+    if (analysis.everyBoxCounts()) {
+        for (std::size_t i = 0; i < level.size(); ++i) {
+            if (analysis.isDeadSquare(i) && !level.isGoal(i)) set(dead, i);
+        }
+    }
+
+    players.resize(count);
+    boxes.resize(count * words);
+    onGoals.resize(count);
+    moveCounts.resize(count);
+    pushCounts.resize(count);
+    blockedCounts.resize(count);
+    lostFlags.resize(count);
+    reset();
+}
+
+void BatchSim::reset() {
+    for (std::size_t i = 0; i < size(); ++i) {
+        reset(i);
+    }
+}
+
+void BatchSim::reset(std::size_t i) {
+    players[i] = startPlayer;
+    std::copy(startBoxes.begin(), startBoxes.end(),
+        boxes.begin() + i * words);
+    onGoals[i] = startOnGoals;
+    moveCounts[i] = pushCounts[i] = blockedCounts[i] = 0;
+    lostFlags[i] = 0;
+}
+
+// Legality and the box move are worked out with masks rather than
+// branches, so a batch of mixed outcomes keeps the pipeline full
+bool BatchSim::advance(std::size_t i, uint8_t dir) {
+    if (dir >= Stay) return false;
+    uint64_t* mine = &boxes[i * words];
+    uint32_t from = players[i];
+    uint32_t next = from + offsets[dir];
+    bool wall = test(walls.data(), next);
+    // The square beyond a wall may be off the board, so it is not read
+    uint32_t beyond = wall ? next : next + offsets[dir];
+    bool box = test(mine, next);
+    bool jammed = test(walls.data(), beyond) | test(mine, beyond);
+    bool ok = !wall & !(box & jammed);
+    bool push = box & ok;
+
+    uint64_t mask = uint64_t{0} - push;
+    mine[next >> 6] ^= (uint64_t{1} << (next & 63)) & mask;
+    mine[beyond >> 6] ^= (uint64_t{1} << (beyond & 63)) & mask;
+    onGoals[i] += push * (static_cast<int>(test(goals.data(), beyond))
+        - static_cast<int>(test(goals.data(), next)));
+    lostFlags[i] |= push & test(dead.data(), beyond);
+    pushCounts[i] += push;
+    moveCounts[i] += ok;
+    blockedCounts[i] += !ok;
+    players[i] = ok ? next : from;
+    return ok;
+}
+
+std::size_t BatchSim::step(const uint8_t* dirs) {
+    std::size_t moved = 0;
+    for (std::size_t i = 0; i < size(); ++i) {
+        moved += advance(i, dirs[i]);
+    }
+    return moved;
+}
+
+std::size_t BatchSim::step(Direction dir) {
+    std::size_t moved = 0;
+    for (std::size_t i = 0; i < size(); ++i) {
+        moved += advance(i, static_cast<uint8_t>(dir));
+    }
+    return moved;
+}
+
+Board BatchSim::board(std::size_t i) const {
+    Board board = start;
+    for (std::size_t sq = 0; sq < board.size(); ++sq) {
+        board.setPiece(sq, hasBox(i, sq) ? Board::Box : Board::Empty);
+    }
+    board.setPiece(players[i], Board::Player);
+    return board;
+}
+
+std::vector<PlayoutResult> runPlayouts(const Board& level,
+ const std::vector<std::vector<Direction>>& sequences, unsigned int threads,
+ std::size_t batchSize, PlayoutKernel kernel) {
+    batchSize = std::max<std::size_t>(1, batchSize);
+    // Small levels get a kernel with the board size compiled in
+    bool fixed = kernel == PlayoutKernel::Auto;
+    if (fixed && FixedBoard<8, 8>::fits(level)) {
+        return fixedPlayouts<FixedBoard<8, 8>>(level, sequences, threads,
+            batchSize);
+    }
+    if (fixed && FixedBoard<16, 16>::fits(level)) {
+        return fixedPlayouts<FixedBoard<16, 16>>(level, sequences, threads,
+            batchSize);
+    }
+    std::vector<PlayoutResult> results(sequences.size());
+    ThreadPool pool(threads);
+    for (std::size_t first = 0; first < sequences.size();
+     first += batchSize) {
+        pool.submit([&, first] {
+            std::size_t count = std::min(batchSize,
+                sequences.size() - first);
+            BatchSim sim(level, count);
+            std::vector<uint8_t> dirs(count);
+            std::vector<uint8_t> done(count);
+            std::size_t longest = 0;
+            for (std::size_t j = 0; j < count; ++j) {
+                longest = std::max(longest, sequences[first + j].size());
+                done[j] = sim.won(j);
+            }
+            for (std::size_t t = 0; t < longest; ++t) {
+                for (std::size_t j = 0; j < count; ++j) {
+                    const std::vector<Direction>& seq = sequences[first + j];
+                    dirs[j] = done[j] || t >= seq.size() ? BatchSim::Stay
+                        : static_cast<uint8_t>(seq[t]);
+                }
+                sim.step(dirs);
+                for (std::size_t j = 0; j < count; ++j) {
+                    if (dirs[j] != BatchSim::Stay && sim.won(j)) {
+                        done[j] = 1;
+                        results[first + j].length = t + 1;
+                    }
+                }
+            }
+            for (std::size_t j = 0; j < count; ++j) {
+                PlayoutResult& r = results[first + j];
+                r.won = sim.won(j);
+                r.lost = sim.lost(j);
+                r.moves = sim.moves(j);
+                r.pushes = sim.pushes(j);
+                r.blocked = sim.blocked(j);
+                r.boxesOnGoals = sim.boxesOnGoals(j);
+                if (!r.won) r.length = sequences[first + j].size();
+            }
+        });
+    }
+    pool.wait();
+    return results;
+}
+
+}  // namespace SB
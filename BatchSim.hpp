@@ -0,0 +1,115 @@
+//  Copyright 2025 <Orbosa Igbinovia> [legal/copyright]
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Board.hpp"
+
+namespace SB {
+
+//  Many copies of one level stepped together, for tools that score large
+//  numbers of move sequences (hints, difficulty, solution checks). State
+//  is kept as structure of arrays: one array of player squares, one of
+//  counters each, and every instance's boxes as a bitboard in one shared
+//  buffer. Walls, goals and dead squares are bitboards shared by all.
+//  Stepping never allocates and has no journal, so there is no undo;
+//  reset an instance instead.
+class BatchSim {
+ public:
+    //  Direction code that leaves an instance where it is
+    static constexpr uint8_t Stay = 4;
+
+    BatchSim(const Board& level, std::size_t count);
+
+    std::size_t size() const { return players.size(); }
+    //  Every instance, or just one, back to the level's start
+    void reset();
+    void reset(std::size_t i);
+
+    //  One step for every instance: dirs[i] is a Direction cast to
+    //  uint8_t, or Stay. A blocked step leaves the instance in place and
+    //  counts in blocked(i). Returns how many instances moved.
+    std::size_t step(const uint8_t* dirs);
+    std::size_t step(const std::vector<uint8_t>& dirs) {
+        return step(dirs.data());
+    }
+    //  Same direction for all
+    std::size_t step(Direction dir);
+
+    uint32_t player(std::size_t i) const { return players[i]; }
+    bool hasBox(std::size_t i, std::size_t square) const {
+        return test(&boxes[i * words], square);
+    }
+    unsigned int boxesOnGoals(std::size_t i) const { return onGoals[i]; }
+    //  Same rule as GameState::isWon
+    bool won(std::size_t i) const {
+        return onGoals[i] == goalCount || onGoals[i] == boxCount;
+    }
+    unsigned int moves(std::size_t i) const { return moveCounts[i]; }
+    unsigned int pushes(std::size_t i) const { return pushCounts[i]; }
+    unsigned int blocked(std::size_t i) const { return blockedCounts[i]; }
+    //  A box was pushed onto a dead square. Only tracked when every box
+    //  has to reach a goal (see Deadlock::everyBoxCounts).
+    bool lost(std::size_t i) const { return lostFlags[i] != 0; }
+    //  The instance as a Board, for checking against GameState
+    Board board(std::size_t i) const;
+    const Board& level() const { return start; }
+
+ private:
+    Board start;
+    std::size_t words;  //  64 bit words per bitboard
+    std::vector<uint64_t> walls;
+    std::vector<uint64_t> goals;
+    std::vector<uint64_t> dead;
+    int32_t offsets[4];
+    uint32_t startPlayer = 0;
+    unsigned int startOnGoals = 0;
+    unsigned int goalCount = 0;
+    unsigned int boxCount = 0;
+
+    std::vector<uint32_t> players;
+    std::vector<uint64_t> boxes;  //  instance i at [i * words]
+    std::vector<uint32_t> onGoals;
+    std::vector<uint32_t> moveCounts;
+    std::vector<uint32_t> pushCounts;
+    std::vector<uint32_t> blockedCounts;
+    std::vector<uint8_t> lostFlags;
+    std::vector<uint64_t> startBoxes;
+
+    static bool test(const uint64_t* bits, std::size_t square) {
+        return (bits[square >> 6] >> (square & 63)) & 1;
+    }
+    //  Applies one step to instance i, true if it moved
+    bool advance(std::size_t i, uint8_t dir);
+};
+
+struct PlayoutResult {
+    bool won = false;
+    bool lost = false;
+    unsigned int moves = 0;
+    unsigned int pushes = 0;
+    unsigned int blocked = 0;
+    unsigned int boxesOnGoals = 0;
+    //  Directions played up to and including the winning one, or the
+    //  whole sequence when it did not win. Later ones are ignored.
+    std::size_t length = 0;
+};
+
+//  What runPlayouts steps the sequences on
+enum class PlayoutKernel : uint8_t {
+    Auto,   //  a FixedBoard when the level fits 16 x 16, else BatchSim
+    Batch   //  BatchSim whatever the size
+};
+
+//  Plays every sequence from the level's start. Sequences are sharded into
+//  batches of batchSize instances, one BatchSim per batch, spread over a
+//  ThreadPool (0 threads for one per hardware thread). With Auto, levels
+//  of up to 16 x 16 squares play on a FixedBoard copy per sequence
+//  instead. Results come back in input order whatever the thread count
+//  or kernel.
+std::vector<PlayoutResult> runPlayouts(const Board& level,
+    const std::vector<std::vector<Direction>>& sequences,
+    unsigned int threads = 0, std::size_t batchSize = 256,
+    PlayoutKernel kernel = PlayoutKernel::Auto);
+
+}  // namespace SB
@@ -0,0 +1,38 @@
+//  Copyright 2025 <Orbosa Igbinovia> [legal/copyright]
+#include "Board.hpp"
+
+namespace SB {
+
+Board::Board() : Board(0, 0) {}
+
+Board::Board(unsigned int width, unsigned int height)
+    : cols(width), rows(height),
+      area(static_cast<std::size_t>(width + 2) * (height + 2)),
+      cells(2 * area, Empty) {
+    // Start with the whole grid as wall, then open up the inside
+    for (std::size_t i = 0; i < area; ++i) {
+        cells[i] = Wall;
+    }
+    for (unsigned int y = 0; y < height; ++y) {
+        for (unsigned int x = 0; x < width; ++x) {
+            cells[index(x, y)] = Floor;
+        }
+    }
+}
+
+char Board::tile(unsigned int x, unsigned int y) const {
+    std::size_t i = index(x, y);
+    if (piece(i) == Player) return '@';
+    if (piece(i) == Box) return 'A';
+    if (isWall(i)) return '#';
+    if (isGoal(i)) return 'a';
+    return '.';
+}
+
+void Board::setTile(unsigned int x, unsigned int y, char c) {
+    std::size_t i = index(x, y);
+    setTerrain(i, c == '#' ? Wall : (c == 'a' || c == '1') ? Goal : Floor);
+    setPiece(i, c == '@' ? Player : (c == 'A' || c == '1') ? Box : Empty);
+}
+
+}  // namespace SB
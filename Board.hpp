@@ -0,0 +1,79 @@
+//  Copyright 2025 <Orbosa Igbinovia> [legal/copyright]
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace SB {
+enum class Direction {
+    Up, Down, Left, Right
+};
+
+//  Row-major board in a single allocation. The level is surrounded by a
+//  one tile wall border, so a step from any square inside the level lands
+//  on a valid index and never needs a bounds check. The first half of the
+//  buffer is the static layer (walls and goals), the second half holds the
+//  player and the boxes.
+class Board {
+ public:
+    //  Static layer
+    static constexpr uint8_t Floor = 0;
+    static constexpr uint8_t Wall = 1;
+    static constexpr uint8_t Goal = 2;
+    //  Dynamic layer
+    static constexpr uint8_t Empty = 0;
+    static constexpr uint8_t Box = 1;
+    static constexpr uint8_t Player = 2;
+
+    Board();
+    Board(unsigned int width, unsigned int height);
+
+    unsigned int width() const { return cols; }
+    unsigned int height() const { return rows; }
+    unsigned int stride() const { return cols + 2; }
+    //  Number of squares including the border
+    std::size_t size() const { return area; }
+
+    std::size_t index(unsigned int x, unsigned int y) const {
+        return (y + 1) * static_cast<std::size_t>(cols + 2) + x + 1;
+    }
+    unsigned int column(std::size_t i) const { return i % (cols + 2) - 1; }
+    unsigned int row(std::size_t i) const { return i / (cols + 2) - 1; }
+    //  Index offset of one step in the given direction
+    std::ptrdiff_t step(Direction dir) const {
+        switch (dir) {
+            case Direction::Up:
+                return -static_cast<std::ptrdiff_t>(cols + 2);
+            case Direction::Down:  return cols + 2;
+            case Direction::Left:  return -1;
+            case Direction::Right: return 1;
+        }
+        return 0;
+    }
+
+    uint8_t terrain(std::size_t i) const { return cells[i]; }
+    uint8_t piece(std::size_t i) const { return cells[area + i]; }
+    void setTerrain(std::size_t i, uint8_t t) { cells[i] = t; }
+    void setPiece(std::size_t i, uint8_t p) { cells[area + i] = p; }
+
+    bool isWall(std::size_t i) const { return cells[i] == Wall; }
+    bool isGoal(std::size_t i) const { return cells[i] == Goal; }
+    bool hasBox(std::size_t i) const { return cells[area + i] == Box; }
+    //  Walkable, and nothing standing on it
+    bool isFree(std::size_t i) const {
+        return cells[i] != Wall && cells[area + i] == Empty;
+    }
+
+    //  Level file characters: '#' wall, '.' floor, 'a' goal, 'A' box,
+    //  '1' box on a goal, '@' player
+    char tile(unsigned int x, unsigned int y) const;
+    void setTile(unsigned int x, unsigned int y, char c);
+
+ private:
+    unsigned int cols;
+    unsigned int rows;
+    std::size_t area;
+    std::vector<uint8_t> cells;
+};
+
+}  // namespace SB
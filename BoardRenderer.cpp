@@ -0,0 +1,245 @@
+//  Copyright 2025 <Orbosa Igbinovia> [legal/copyright]
+#include "BoardRenderer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include "AssetCache.hpp"
+
+namespace SB {
+
+BoardRenderer::BoardRenderer(unsigned int tileSize)
+    : tileSize(tileSize),
+      tiles{"block_06.png", "ground_01.png", "ground_04.png", "crate_03.png",
+            "player_08.png", "player_05.png", "player_20.png",
+            "player_17.png"},
+      atlas(&AssetCache::instance().atlas(tiles, tileSize)),
+      ground(sf::Quads), pieces(sf::Quads) {}
+
+bool BoardRenderer::loadTile(Slot slot, const std::string& filename) {
+    const sf::Image* image = AssetCache::instance().image(filename);
+    if (image == nullptr
+     || image->getSize() != sf::Vector2u(tileSize, tileSize)) {
+        return false;
+    }
+    tiles[slot] = filename;
+    atlas = &AssetCache::instance().atlas(tiles, tileSize);
+    return true;
+}
+
+void BoardRenderer::setQuad(sf::VertexArray& quads, std::size_t quad,
+ sf::Vector2u square, Slot slot) {
+    float size = static_cast<float>(tileSize);
+    float x = square.x * size, y = square.y * size;
+    float u = static_cast<float>(slot) * size;
+    sf::Vertex* v = &quads[quad * 4];
+    v[0] = sf::Vertex({x, y}, {u, 0.f});
+    v[1] = sf::Vertex({x + size, y}, {u + size, 0.f});
+    v[2] = sf::Vertex({x + size, y + size}, {u + size, size});
+    v[3] = sf::Vertex({x, y + size}, {u, size});
+}
+
+void BoardRenderer::build(const Board& board,
+ const std::vector<sf::Vector2u>& boxes, sf::Vector2u player) {
+    std::size_t squares = static_cast<std::size_t>(board.width())
+        * board.height();
+    // Boards over the canvas budget are drawn straight from the chunks,
+    // a board sized canvas per renderer would cost gigabytes on big ones
+    unsigned int limit = sf::Texture::getMaximumSize();
+    std::size_t pixels = squares * tileSize * tileSize;
+    cached = pixels <= MaxCanvasPixels
+        && board.width() * tileSize <= limit
+        && board.height() * tileSize <= limit;
+    if (cached && !canvas) {
+        canvas = std::make_unique<sf::RenderTexture>();
+    }
+    cached = cached
+        && canvas->create(board.width() * tileSize, board.height() * tileSize);
+    if (!cached) {
+        canvas.reset();  // frees the last level's canvas
+    }
+    canvasReady = false;
+    dirtyTiles.clear();
+    dirtyMarks.assign(cached ? squares : 0, 0);
+
+    chunkCols = (board.width() + ChunkSize - 1) / ChunkSize;
+    unsigned int chunkRows = (board.height() + ChunkSize - 1) / ChunkSize;
+    ground.resize(cached ? squares * 4 : 0);
+    chunks.assign(cached ? 0 : chunkCols * chunkRows,
+        sf::VertexArray(sf::Quads));
+    for (unsigned int y = 0; y < board.height(); ++y) {
+        for (unsigned int x = 0; x < board.width(); ++x) {
+            std::size_t i = board.index(x, y);
+            Slot slot = board.isWall(i) ? WallTile
+                : board.isGoal(i) ? GoalTile : FloorTile;
+            sf::VertexArray& quads = cached ? ground
+                : chunks[(y / ChunkSize) * chunkCols + x / ChunkSize];
+            std::size_t quad = static_cast<std::size_t>(y) * board.width()
+                + x;
+            if (!cached) {
+                quad = quads.getVertexCount() / 4;
+                quads.resize(quads.getVertexCount() + 4);
+            }
+            setQuad(quads, quad, {x, y}, slot);
+        }
+    }
+
+    cols = board.width();
+    rows = board.height();
+    occupant.assign(squares, -1);
+    pieceSquares.assign(boxes.size() + 1, sf::Vector2u());
+    pieces.resize((boxes.size() + 1) * 4);
+    for (std::size_t b = 0; b < boxes.size(); ++b) {
+        setQuad(pieces, b, boxes[b], BoxTile);
+        pieceSquares[b] = boxes[b];
+        occupant[boxes[b].y * cols + boxes[b].x] = static_cast<int32_t>(b);
+    }
+    playerSquare = player;
+    pieceSquares.back() = player;
+    occupant[player.y * cols + player.x] =
+        static_cast<int32_t>(boxes.size());
+    setQuad(pieces, boxes.size(), player, facing);
+}
+
+void BoardRenderer::movePiece(std::size_t quad, sf::Vector2u square,
+ Slot slot) {
+    sf::Vector2u from = pieceSquares[quad];
+    // Only clear the old square if another piece has not moved in already
+    int32_t& left = occupant[from.y * cols + from.x];
+    if (left == static_cast<int32_t>(quad)) left = -1;
+    occupant[square.y * cols + square.x] = static_cast<int32_t>(quad);
+    pieceSquares[quad] = square;
+    setQuad(pieces, quad, square, slot);
+    markDirty(from);
+    markDirty(square);
+}
+
+// Each square is listed once however often it changes between draws, so
+// the list never outgrows the board
+void BoardRenderer::markDirty(sf::Vector2u square) {
+    if (!cached || !canvasReady) {
+        return;  // no canvas, or the next draw paints all of it anyway
+    }
+    uint8_t& marked = dirtyMarks[square.y * cols + square.x];
+    if (!marked) {
+        marked = 1;
+        dirtyTiles.push_back(square);
+    }
+}
+
+void BoardRenderer::placeBox(std::size_t box, sf::Vector2u square) {
+    movePiece(box, square, BoxTile);
+}
+
+void BoardRenderer::placePlayer(sf::Vector2u square) {
+    playerSquare = square;
+    movePiece(pieces.getVertexCount() / 4 - 1, square, facing);
+}
+
+void BoardRenderer::face(Direction dir) {
+    switch (dir) {
+        case Direction::Up:    facing = PlayerUp; break;
+        case Direction::Down:  facing = PlayerDown; break;
+        case Direction::Left:  facing = PlayerLeft; break;
+        case Direction::Right: facing = PlayerRight; break;
+    }
+    if (pieces.getVertexCount() > 0) {
+        placePlayer(playerSquare);
+    }
+}
+
+// Paints the whole board into the canvas the first time, and after that
+// only the squares pieces have entered or left, in one batched draw
+void BoardRenderer::repaint() const {
+    sf::RenderStates states(atlas);
+    if (!canvasReady) {
+        canvas->clear();
+        canvas->draw(ground, states);
+        canvas->draw(pieces, states);
+    } else if (!dirtyTiles.empty()) {
+        patch.clear();
+        for (sf::Vector2u square : dirtyTiles) {
+            std::size_t tile = square.y * cols + square.x;
+            for (std::size_t v = 0; v < 4; ++v) {
+                patch.push_back(ground[tile * 4 + v]);
+            }
+            if (occupant[tile] >= 0) {
+                for (std::size_t v = 0; v < 4; ++v) {
+                    patch.push_back(pieces[occupant[tile] * 4 + v]);
+                }
+            }
+        }
+        canvas->draw(patch.data(), patch.size(), sf::Quads, states);
+    } else {
+        return;
+    }
+    canvas->display();
+    canvasReady = true;
+    for (sf::Vector2u square : dirtyTiles) {
+        dirtyMarks[square.y * cols + square.x] = 0;
+    }
+    dirtyTiles.clear();
+}
+
+sf::IntRect BoardRenderer::visibleTiles(const sf::View& view) const {
+    float size = static_cast<float>(tileSize);
+    sf::Vector2f half = view.getSize() / 2.f;
+    sf::Vector2f center = view.getCenter();
+    int x0 = static_cast<int>(std::floor((center.x - half.x) / size));
+    int y0 = static_cast<int>(std::floor((center.y - half.y) / size));
+    int x1 = static_cast<int>(std::ceil((center.x + half.x) / size));
+    int y1 = static_cast<int>(std::ceil((center.y + half.y) / size));
+    x0 = std::max(x0, 0);
+    y0 = std::max(y0, 0);
+    x1 = std::min(x1, static_cast<int>(cols));
+    y1 = std::min(y1, static_cast<int>(rows));
+    return sf::IntRect(x0, y0, std::max(0, x1 - x0), std::max(0, y1 - y0));
+}
+
+// The ground chunks touching the view, then the pieces on its squares
+// in one batch, found through the occupant grid
+void BoardRenderer::drawVisible(sf::RenderTarget& target,
+ sf::RenderStates states) const {
+    sf::IntRect seen = visibleTiles(target.getView());
+    quadsDrawn = 0;
+    if (seen.width == 0 || seen.height == 0) return;
+    unsigned int cx0 = seen.left / ChunkSize;
+    unsigned int cy0 = seen.top / ChunkSize;
+    unsigned int cx1 = (seen.left + seen.width - 1) / ChunkSize;
+    unsigned int cy1 = (seen.top + seen.height - 1) / ChunkSize;
+    for (unsigned int cy = cy0; cy <= cy1; ++cy) {
+        for (unsigned int cx = cx0; cx <= cx1; ++cx) {
+            const sf::VertexArray& chunk = chunks[cy * chunkCols + cx];
+            target.draw(chunk, states);
+            quadsDrawn += chunk.getVertexCount() / 4;
+        }
+    }
+
+    patch.clear();
+    for (int y = seen.top; y < seen.top + seen.height; ++y) {
+        for (int x = seen.left; x < seen.left + seen.width; ++x) {
+            int32_t quad = occupant[static_cast<std::size_t>(y) * cols + x];
+            if (quad < 0) continue;
+            for (std::size_t v = 0; v < 4; ++v) {
+                patch.push_back(pieces[quad * 4 + v]);
+            }
+        }
+    }
+    if (!patch.empty()) {
+        target.draw(patch.data(), patch.size(), sf::Quads, states);
+        quadsDrawn += patch.size() / 4;
+    }
+}
+
+void BoardRenderer::draw(sf::RenderTarget& target,
+ sf::RenderStates states) const {
+    if (cached) {
+        repaint();
+        target.draw(sf::Sprite(canvas->getTexture()), states);
+        quadsDrawn = 1;
+        return;
+    }
+    states.texture = atlas;
+    drawVisible(target, states);
+}
+
+}  // namespace SB
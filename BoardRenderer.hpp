@@ -0,0 +1,88 @@
+//  Copyright 2025 <Orbosa Igbinovia> [legal/copyright]
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+#include <SFML/Graphics.hpp>
+#include "Board.hpp"
+
+namespace SB {
+
+//  Draws a board from one atlas texture in two draw calls. The ground
+//  (walls, floor, goals) is built once into a vertex array; boxes and the
+//  player sit in a second array with one quad each, so a move only
+//  rewrites the quads that actually changed. The atlas itself comes from
+//  the process-wide AssetCache, so renderers with the same tiles share it.
+//
+//  When the board is at most MaxCanvasPixels it is also kept pre-rendered
+//  in an off-screen canvas. Moves mark the squares they touch, and a draw only
+//  repaints those squares into the canvas, then shows the canvas as one
+//  sprite.
+//
+//  Bigger boards keep the ground in ChunkSize square chunks instead, and
+//  a draw only sends the chunks and pieces inside the target's view, so
+//  its cost follows the window size and not the board size.
+class BoardRenderer : public sf::Drawable {
+ public:
+    //  Tiles in the atlas, laid out left to right
+    enum Slot {
+        WallTile, FloorTile, GoalTile, BoxTile,
+        PlayerUp, PlayerDown, PlayerLeft, PlayerRight,
+        SlotCount
+    };
+    static constexpr unsigned int ChunkSize = 32;
+    //  Largest canvas, 16 MiB of RGBA (a 32 x 32 level at 64 pixels)
+    static constexpr std::size_t MaxCanvasPixels = 2048 * 2048;
+
+    explicit BoardRenderer(unsigned int tileSize);
+    //  Swaps the image used for one slot
+    bool loadTile(Slot slot, const std::string& filename);
+    void build(const Board& board, const std::vector<sf::Vector2u>& boxes,
+        sf::Vector2u player);
+    void placeBox(std::size_t box, sf::Vector2u square);
+    void placePlayer(sf::Vector2u square);
+    void face(Direction dir);
+    //  Squares waiting to be repainted into the canvas
+    std::size_t pendingTiles() const { return dirtyTiles.size(); }
+    //  Quads sent by the last draw, the canvas counting as one
+    std::size_t drawnQuads() const { return quadsDrawn; }
+    //  Squares at least partly inside the view, clipped to the board
+    sf::IntRect visibleTiles(const sf::View& view) const;
+
+ protected:
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+ private:
+    unsigned int tileSize;
+    std::vector<std::string> tiles;  //  image file for each slot
+    const sf::Texture* atlas;
+    sf::VertexArray ground;  //  whole board, only kept with the canvas
+    std::vector<sf::VertexArray> chunks;  //  ground without the canvas
+    unsigned int chunkCols = 0;
+    sf::VertexArray pieces;  //  one quad per box, the player quad last
+    Slot facing = PlayerDown;
+    sf::Vector2u playerSquare;
+    unsigned int cols = 0;
+    unsigned int rows = 0;
+    //  Square of each quad in pieces, and the quad on each square (-1)
+    std::vector<sf::Vector2u> pieceSquares;
+    std::vector<int32_t> occupant;
+    bool cached = false;  //  board fits in the canvas
+    std::unique_ptr<sf::RenderTexture> canvas;  //  only while cached
+    mutable bool canvasReady = false;
+    mutable std::vector<sf::Vector2u> dirtyTiles;
+    mutable std::vector<uint8_t> dirtyMarks;  //  per square, set if listed
+    mutable std::vector<sf::Vertex> patch;  //  repaint batch, reused
+    mutable std::size_t quadsDrawn = 0;
+
+    void setQuad(sf::VertexArray& quads, std::size_t quad,
+        sf::Vector2u square, Slot slot);
+    //  Moves a piece quad and marks the squares it left and entered
+    void movePiece(std::size_t quad, sf::Vector2u square, Slot slot);
+    void markDirty(sf::Vector2u square);
+    void repaint() const;
+    void drawVisible(sf::RenderTarget& target, sf::RenderStates states)
+        const;
+};
+
+}  // namespace SB
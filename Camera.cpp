@@ -0,0 +1,68 @@
+//  Copyright 2025 <Orbosa Igbinovia> [legal/copyright]
+#include "Camera.hpp"
+#include <algorithm>
+
+namespace SB {
+
+Camera::Camera(unsigned int tileSize)
+    : tileSize(static_cast<float>(tileSize)) {}
+
+void Camera::reset(sf::Vector2u levelTiles, sf::Vector2u windowPixels) {
+    level = sf::Vector2f(levelTiles.x * tileSize, levelTiles.y * tileSize);
+    window = sf::Vector2f(windowPixels);
+    float fit = std::min(window.x / level.x, window.y / level.y);
+    scale = fit >= 1.f ? std::min(fit, MaxZoom) : 1.f;
+    center = level / 2.f;
+    clamp();
+}
+
+void Camera::resize(sf::Vector2u windowPixels) {
+    window = sf::Vector2f(windowPixels);
+    scale = std::clamp(scale, minZoom(), MaxZoom);
+    clamp();
+}
+
+float Camera::minZoom() const {
+    // Zooming out stops once the whole level shows, or at the tile cap
+    float fit = std::min(window.x / level.x, window.y / level.y);
+    float cap = std::max(window.x, window.y) / (MaxVisibleTiles * tileSize);
+    return std::min(1.f, std::max(fit, cap));
+}
+
+bool Camera::follow(sf::Vector2u square) {
+    sf::Vector2f old = center;
+    sf::Vector2f half = viewSize() / 2.f;
+    // A small view gets a smaller margin so the square always fits
+    float mx = std::min(Margin * tileSize, half.x - tileSize);
+    float my = std::min(Margin * tileSize, half.y - tileSize);
+    mx = std::max(mx, 0.f);
+    my = std::max(my, 0.f);
+    float left = square.x * tileSize, top = square.y * tileSize;
+    center.x = std::max(std::min(center.x, left - mx + half.x),
+        left + tileSize + mx - half.x);
+    center.y = std::max(std::min(center.y, top - my + half.y),
+        top + tileSize + my - half.y);
+    clamp();
+    return center != old;
+}
+
+bool Camera::zoomBy(float factor) {
+    float old = scale;
+    scale = std::clamp(scale * factor, minZoom(), MaxZoom);
+    clamp();
+    return scale != old;
+}
+
+void Camera::clamp() {
+    sf::Vector2f half = viewSize() / 2.f;
+    center.x = level.x <= 2 * half.x ? level.x / 2
+        : std::clamp(center.x, half.x, level.x - half.x);
+    center.y = level.y <= 2 * half.y ? level.y / 2
+        : std::clamp(center.y, half.y, level.y - half.y);
+}
+
+sf::View Camera::view() const {
+    return sf::View(center, viewSize());
+}
+
+}  // namespace SB
@@ -0,0 +1,48 @@
+//  Copyright 2025 <Orbosa Igbinovia> [legal/copyright]
+#pragma once
+#include <SFML/Graphics.hpp>
+
+namespace SB {
+
+//  Which part of the level the window shows. Levels that fit are scaled
+//  to fill the window as before; bigger ones are shown at a readable zoom
+//  and scroll to keep the player away from the edges. The view never
+//  shows more than MaxVisibleTiles across, so the tiles drawn each frame
+//  depend on the window and not on the level.
+class Camera {
+ public:
+    static constexpr float MaxZoom = 4.f;
+    static constexpr unsigned int MaxVisibleTiles = 160;
+    //  Squares kept between the player and the edge of the view
+    static constexpr unsigned int Margin = 4;
+
+    explicit Camera(unsigned int tileSize);
+    //  New level: fits it in the window if it can, else zooms to 1
+    void reset(sf::Vector2u levelTiles, sf::Vector2u windowPixels);
+    //  Window resized, keeps the zoom and the place looked at
+    void resize(sf::Vector2u windowPixels);
+    //  Scrolls just enough to keep the square inside the margin. True if
+    //  the view moved.
+    bool follow(sf::Vector2u square);
+    //  factor above 1 zooms in. True if the zoom changed.
+    bool zoomBy(float factor);
+
+    float zoom() const { return scale; }
+    //  BoardRenderer::visibleTiles gives the squares it shows
+    sf::View view() const;
+
+ private:
+    float tileSize;
+    sf::Vector2f level;   //  pixels
+    sf::Vector2f window;  //  pixels
+    sf::Vector2f center;
+    float scale = 1.f;
+
+    float minZoom() const;
+    sf::Vector2f viewSize() const { return {window.x / scale,
+        window.y / scale}; }
+    //  Keeps the view inside the level, centring axes the level fits on
+    void clamp();
+};
+
+}  // namespace SB
@@ -0,0 +1,80 @@
+//  Copyright 2025 <Orbosa Igbinovia> [legal/copyright]
+#include "Deadlock.hpp"
+#include <algorithm>
+
+namespace SB {
+
+Deadlock::Deadlock(const Board& level)
+    : walls(level.size(), 0), goals(level.size(), 0),
+      dead(level.size(), 1), stride(level.stride()) {
+    std::vector<std::size_t> queue;
+    for (std::size_t i = 0; i < level.size(); ++i) {
+        walls[i] = level.isWall(i);
+        goals[i] = level.isGoal(i);
+        boxCount += level.hasBox(i);
+        if (goals[i]) {
+            dead[i] = 0;
+            queue.push_back(i);
+        }
+    }
+    goalCount = queue.size();
+    strict = boxCount <= goalCount;
+
+    // A square is live if a box on it can be pushed to some goal. Pulling
+    // boxes backwards out of every goal at once finds all of them.
+    const std::ptrdiff_t steps[4] = {1, -1,
+        static_cast<std::ptrdiff_t>(stride),
+        -static_cast<std::ptrdiff_t>(stride)};
+    for (std::size_t head = 0; head < queue.size(); ++head) {
+        std::size_t box = queue[head];
+        for (std::ptrdiff_t d : steps) {
+            std::size_t from = box + d, player = box + 2 * d;
+            if (player >= walls.size() || walls[from] || walls[player]
+             || !dead[from]) {
+                continue;
+            }
+            dead[from] = 0;
+            queue.push_back(from);
+        }
+    }
+    for (std::size_t i = 0; i < walls.size(); ++i) {
+        if (walls[i]) dead[i] = 0;
+    }
+}
+
+bool Deadlock::isLost(const Board& board, Scratch& scratch) const {
+    auto hasBox = [&board](std::size_t sq) { return board.hasBox(sq); };
+    // Boxes and empty goals shut in frozen corrals
+    std::vector<uint8_t>& locked = scratch.locked;
+    locked.assign(board.size(), 0);
+    std::size_t lockedGoals = 0;
+    std::size_t player = board.size();
+    for (std::size_t i = 0; i < board.size(); ++i) {
+        if (board.piece(i) == Board::Player) player = i;
+    }
+    if (player < board.size()) {
+        reach(player, hasBox, scratch);
+        for (std::size_t i = 0; i < board.size(); ++i) {
+            if (walls[i] || scratch.mark[i] >= scratch.reach) continue;
+            if (!frozenCorral(i, hasBox, scratch)) continue;
+            for (std::size_t sq : scratch.queue) {
+                locked[sq] = 1;
+                lockedGoals += goals[sq] && !board.hasBox(sq);
+            }
+        }
+    }
+
+    std::size_t stuckBoxes = 0;
+    for (std::size_t i = 0; i < board.size(); ++i) {
+        if (!board.hasBox(i) || goals[i]) continue;
+        if (dead[i] || locked[i] || stuck(i, hasBox)) {
+            ++stuckBoxes;
+        }
+    }
+    // Every goal needs a box, or every box needs a goal (see isWon)
+    std::size_t needed = std::min(boxCount, goalCount);
+    return boxCount - std::min(stuckBoxes, boxCount) < needed
+        || (boxCount >= goalCount && lockedGoals > 0);
+}
+
+}  // namespace SB
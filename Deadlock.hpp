@@ -0,0 +1,243 @@
+//  Copyright 2025 <Orbosa Igbinovia> [legal/copyright]
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Board.hpp"
+#include "Profiler.hpp"
+
+namespace SB {
+
+//  Positions that can no longer be won. Built once per level from the
+//  static layer; the checks after a push only look at the squares around
+//  the box that moved.
+//
+//  A box is stuck when it sits off a goal and either
+//   - is on a dead square, from which no push sequence reaches a goal, or
+//   - is frozen: blocked on both axes by walls, dead squares or other
+//     frozen boxes (a 2x2 block of walls and boxes is the simplest case).
+//  A box is also stuck inside a frozen corral: squares the player cannot
+//  reach, fenced off by boxes that no push from the player's side can
+//  move. Nothing in such a corral ever moves again, so an empty goal in
+//  it stays empty too.
+//  The level is lost once fewer boxes than needed can still reach a goal.
+//  With spare boxes a stuck box is only a spare, not a loss.
+class Deadlock {
+ public:
+    //  Marks for the corral check, reused across calls by one thread
+    struct Scratch {
+        std::vector<uint32_t> mark;
+        std::vector<std::size_t> queue;
+        std::vector<uint8_t> locked;  //  isLost: squares in frozen corrals
+        uint32_t reach = 0;  //  stamp of the squares the player reaches
+        uint32_t stamp = 0;
+    };
+
+    explicit Deadlock(const Board& level);
+
+    bool isDeadSquare(std::size_t square) const { return dead[square] != 0; }
+    //  True when every box has to end on a goal, so one stuck box loses
+    bool everyBoxCounts() const { return strict; }
+
+    //  Whether pushing a box onto square lost the game, given where the
+    //  player stands and which squares hold boxes afterwards, when the
+    //  position before the push was not lost. hasBox(square) -> bool.
+    //  With spare boxes true only means a box near the push got stuck or
+    //  fenced in; isLost then counts whether enough are left.
+    template <class HasBox>
+    bool afterPush(std::size_t square, std::size_t player,
+        const HasBox& hasBox, Scratch& scratch) const;
+    //  Full check of a position, used on load and to confirm afterPush
+    //  with spare boxes
+    bool isLost(const Board& board, Scratch& scratch) const;
+    bool isLost(const Board& board) const {
+        Scratch scratch;
+        return isLost(board, scratch);
+    }
+
+ private:
+    //  Boxes already on the freeze search path are treated as walls
+    struct Chain {
+        static constexpr std::size_t Capacity = 16;
+        std::size_t squares[Capacity];
+        std::size_t size = 0;
+        bool contains(std::size_t square) const {
+            for (std::size_t i = 0; i < size; ++i) {
+                if (squares[i] == square) return true;
+            }
+            return false;
+        }
+    };
+
+    std::vector<uint8_t> walls;
+    std::vector<uint8_t> goals;
+    std::vector<uint8_t> dead;
+    std::size_t stride;
+    std::size_t boxCount = 0;
+    std::size_t goalCount = 0;
+    bool strict;
+
+    template <class HasBox>
+    bool stuck(std::size_t box, const HasBox& hasBox) const;
+    template <class HasBox>
+    bool inBlock(std::size_t box, const HasBox& hasBox) const;
+    template <class HasBox>
+    bool frozen(std::size_t box, const HasBox& hasBox, Chain& chain) const;
+    template <class HasBox>
+    bool blocked(std::size_t box, std::size_t step, const HasBox& hasBox,
+        Chain& chain) const;
+    //  Marks the squares the player can walk to with scratch.reach
+    template <class HasBox>
+    void reach(std::size_t player, const HasBox& hasBox, Scratch& scratch)
+        const;
+    //  Whether the squares off the player's reach joined to seed form a
+    //  frozen corral. Leaves them in scratch.queue.
+    template <class HasBox>
+    bool frozenCorral(std::size_t seed, const HasBox& hasBox,
+        Scratch& scratch) const;
+};
+
+template <class HasBox>
+bool Deadlock::afterPush(std::size_t square, std::size_t player,
+ const HasBox& hasBox, Scratch& scratch) const {
+    if (!goals[square] && dead[square]) {
+        return true;
+    }
+    // The pushed box can also pin a neighbour that is off a goal
+    const std::size_t around[5] = {square, square - 1, square + 1,
+        square - stride, square + stride};
+    for (std::size_t box : around) {
+        if (hasBox(box) && stuck(box, hasBox)) {
+            return true;
+        }
+    }
+    // While the box can go on the same way it fences nothing in
+    std::size_t ahead = 2 * square - player;
+    if (!walls[ahead] && !hasBox(ahead)) {
+        return false;
+    }
+    SB_PROFILE_COUNT("corral_check");
+    reach(player, hasBox, scratch);
+    if (!frozenCorral(square, hasBox, scratch)) {
+        return false;
+    }
+    for (std::size_t sq : scratch.queue) {
+        if (hasBox(sq) ? !goals[sq] : goals[sq] && boxCount >= goalCount) {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <class HasBox>
+bool Deadlock::stuck(std::size_t box, const HasBox& hasBox) const {
+    if (goals[box]) {
+        return false;
+    }
+    if (inBlock(box, hasBox)) {
+        return true;
+    }
+    Chain chain;
+    return frozen(box, hasBox, chain);
+}
+
+// Any 2x2 square of walls and boxes holding this box
+template <class HasBox>
+bool Deadlock::inBlock(std::size_t box, const HasBox& hasBox) const {
+    auto solid = [&](std::size_t sq) { return walls[sq] || hasBox(sq); };
+    for (std::size_t dx : {box - 1, box + 1}) {
+        for (std::size_t dy : {box - stride, box + stride}) {
+            if (solid(dx) && solid(dy) && solid(dx + dy - box)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+template <class HasBox>
+bool Deadlock::frozen(std::size_t box, const HasBox& hasBox,
+ Chain& chain) const {
+    if (chain.size == Chain::Capacity) {
+        return false;  // give up rather than guess
+    }
+    chain.squares[chain.size++] = box;
+    bool result = blocked(box, 1, hasBox, chain)
+        && blocked(box, stride, hasBox, chain);
+    --chain.size;
+    return result;
+}
+
+// Whether the box can never move along one axis
+template <class HasBox>
+bool Deadlock::blocked(std::size_t box, std::size_t step, const HasBox& hasBox,
+ Chain& chain) const {
+    std::size_t a = box - step, b = box + step;
+    if (walls[a] || walls[b] || chain.contains(a) || chain.contains(b)) {
+        return true;
+    }
+    if (strict && dead[a] && dead[b]) {
+        return true;
+    }
+    return (hasBox(a) && frozen(a, hasBox, chain))
+        || (hasBox(b) && frozen(b, hasBox, chain));
+}
+
+template <class HasBox>
+void Deadlock::reach(std::size_t player, const HasBox& hasBox,
+ Scratch& scratch) const {
+    if (scratch.mark.size() != walls.size()) {
+        scratch.mark.assign(walls.size(), 0);
+    }
+    scratch.reach = ++scratch.stamp;
+    scratch.mark[player] = scratch.reach;
+    scratch.queue.assign(1, player);
+    for (std::size_t head = 0; head < scratch.queue.size(); ++head) {
+        std::size_t sq = scratch.queue[head];
+        for (std::size_t next : {sq - 1, sq + 1, sq - stride, sq + stride}) {
+            if (walls[next] || hasBox(next)
+             || scratch.mark[next] == scratch.reach) {
+                continue;
+            }
+            scratch.mark[next] = scratch.reach;
+            scratch.queue.push_back(next);
+        }
+    }
+}
+
+// No box of the corral can be pushed from a square the player reaches.
+// Every other square next to the corral is a wall, so while that holds
+// the player never gets in and nothing in it moves.
+template <class HasBox>
+bool Deadlock::frozenCorral(std::size_t seed, const HasBox& hasBox,
+ Scratch& scratch) const {
+    const uint32_t corral = ++scratch.stamp;
+    auto reached = [&](std::size_t sq) {
+        return scratch.mark[sq] == scratch.reach;
+    };
+    auto free = [&](std::size_t sq) { return !walls[sq] && !hasBox(sq); };
+    bool frozen = true;
+    scratch.mark[seed] = corral;
+    scratch.queue.assign(1, seed);
+    for (std::size_t head = 0; head < scratch.queue.size(); ++head) {
+        std::size_t sq = scratch.queue[head];
+        if (hasBox(sq)) {
+            for (std::size_t step : {std::size_t{1}, stride}) {
+                if ((reached(sq - step) && free(sq + step))
+                 || (reached(sq + step) && free(sq - step))) {
+                    frozen = false;
+                }
+            }
+        }
+        for (std::size_t next : {sq - 1, sq + 1, sq - stride, sq + stride}) {
+            if (walls[next] || reached(next) || scratch.mark[next] == corral) {
+                continue;
+            }
+            scratch.mark[next] = corral;
+            scratch.queue.push_back(next);
+        }
+    }
+    return frozen;
+}
+
+}  // namespace SB
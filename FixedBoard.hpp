@@ -0,0 +1,304 @@
+//  Copyright 2025 <Orbosa Igbinovia> [legal/copyright]
+#pragma once
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include "Board.hpp"
+#include "Deadlock.hpp"
+
+namespace SB {
+
+//  Fixed-size bit set of Words 64 bit words, kept by value so small boards
+//  live in registers. Bit i is square i of a FixedBoard.
+template <std::size_t Words>
+struct Bits {
+    uint64_t word[Words] = {};
+
+    constexpr bool test(unsigned int i) const {
+        return (word[i >> 6] >> (i & 63)) & 1;
+    }
+    constexpr void set(unsigned int i) {
+        word[i >> 6] |= uint64_t{1} << (i & 63);
+    }
+    constexpr void reset(unsigned int i) {
+        word[i >> 6] &= ~(uint64_t{1} << (i & 63));
+    }
+    constexpr bool any() const {
+        uint64_t all = 0;
+        for (std::size_t i = 0; i < Words; ++i) all |= word[i];
+        return all != 0;
+    }
+    constexpr unsigned int count() const {
+        unsigned int n = 0;
+        for (std::size_t i = 0; i < Words; ++i) n += std::popcount(word[i]);
+        return n;
+    }
+    //  Every bit moved S places towards the high end, or the low end
+    template <unsigned int S>
+    constexpr Bits up() const {
+        static_assert(S > 0 && S < 64, "shift within one word");
+        Bits out;
+        for (std::size_t i = Words; i-- > 0;) {
+            out.word[i] = word[i] << S
+                | (i > 0 ? word[i - 1] >> (64 - S) : 0);
+        }
+        return out;
+    }
+    template <unsigned int S>
+    constexpr Bits down() const {
+        static_assert(S > 0 && S < 64, "shift within one word");
+        Bits out;
+        for (std::size_t i = 0; i < Words; ++i) {
+            out.word[i] = word[i] >> S
+                | (i + 1 < Words ? word[i + 1] << (64 - S) : 0);
+        }
+        return out;
+    }
+
+    friend constexpr Bits operator&(Bits a, const Bits& b) {
+        for (std::size_t i = 0; i < Words; ++i) a.word[i] &= b.word[i];
+        return a;
+    }
+    friend constexpr Bits operator|(Bits a, const Bits& b) {
+        for (std::size_t i = 0; i < Words; ++i) a.word[i] |= b.word[i];
+        return a;
+    }
+    friend constexpr Bits operator~(Bits a) {
+        for (std::size_t i = 0; i < Words; ++i) a.word[i] = ~a.word[i];
+        return a;
+    }
+    friend constexpr bool operator==(const Bits& a, const Bits& b) {
+        for (std::size_t i = 0; i < Words; ++i) {
+            if (a.word[i] != b.word[i]) return false;
+        }
+        return true;
+    }
+};
+
+using Bits256 = Bits<4>;
+
+//  Every square of a W x H board except those in column skip (pass W to
+//  skip none)
+template <unsigned int W, unsigned int H, class Set>
+constexpr Set boardMask(unsigned int skip) {
+    Set set;
+    for (unsigned int y = 0; y < H; ++y) {
+        for (unsigned int x = 0; x < W; ++x) {
+            if (x != skip) set.set(y * W + x);
+        }
+    }
+    return set;
+}
+
+//  A level of at most W x H squares with the size fixed at compile time.
+//  Walls, goals, boxes and dead squares are bitboards of W * H bits
+//  (square y * W + x), with everything outside the level counted as wall,
+//  so a board is a few words held by value with no heap behind it. Moving
+//  the player is index arithmetic on constant strides, and whole-board
+//  questions (where can the player walk, which boxes can be pushed) are
+//  answered with shifts and masks instead of a search.
+//
+//  runPlayouts picks an instance once per level with fits() and keeps
+//  BatchSim for bigger levels. The game stays on GameState whatever the
+//  size: a key press needs the journal, undo and corral checks, none of
+//  which a FixedBoard has, and one move per frame is not where time goes.
+template <unsigned int W, unsigned int H>
+class FixedBoard {
+ public:
+    static_assert(W >= 2 && H >= 2 && W < 64 && W * H <= 256,
+        "FixedBoard is for small levels");
+    static constexpr unsigned int Squares = W * H;
+    using Set = Bits<(Squares + 63) / 64>;
+
+    static bool fits(const Board& level) {
+        return level.width() <= W && level.height() <= H;
+    }
+
+    //  Throws std::invalid_argument when the level does not fit or has no
+    //  player
+    explicit FixedBoard(const Board& level);
+
+    unsigned int player() const { return at; }
+    static constexpr unsigned int square(unsigned int x, unsigned int y) {
+        return y * W + x;
+    }
+    const Set& boxes() const { return boxSet; }
+    const Set& goals() const { return goalSet; }
+    const Set& walls() const { return wallSet; }
+    unsigned int moves() const { return moveCount; }
+    unsigned int pushes() const { return pushCount; }
+    unsigned int boxesOnGoals() const { return (boxSet & goalSet).count(); }
+    //  Same rule as GameState::isWon
+    bool isWon() const {
+        unsigned int on = boxesOnGoals();
+        return on == goalSet.count() || on == boxSet.count();
+    }
+    //  A box was pushed onto a dead square (only tracked when every box
+    //  has to reach a goal, see Deadlock::everyBoxCounts)
+    bool lost() const { return lostFlag; }
+
+    //  Takes one step, pushing a box if there is one. False if blocked.
+    bool move(Direction dir);
+    //  Squares the player can walk to without pushing
+    Set reachable() const;
+    //  Boxes the player can push one square in dir from here
+    Set pushable(Direction dir) const;
+
+    //  Every bit of set moved one square in dir, dropping bits that would
+    //  leave the board
+    template <Direction D>
+    static constexpr Set shift(const Set& set);
+
+ private:
+    Set wallSet;
+    Set goalSet;
+    Set boxSet;
+    Set deadSet;
+    unsigned int at = 0;
+    unsigned int moveCount = 0;
+    unsigned int pushCount = 0;
+    bool lostFlag = false;
+
+    static constexpr Set Inside = boardMask<W, H, Set>(W);
+    static constexpr Set NotLeft = boardMask<W, H, Set>(0);
+    static constexpr Set NotRight = boardMask<W, H, Set>(W - 1);
+
+    //  Square one step from square in dir, false off the board
+    static bool next(unsigned int square, Direction dir, unsigned int& to);
+};
+
+template <unsigned int W, unsigned int H>
+FixedBoard<W, H>::FixedBoard(const Board& level) {
+    if (!fits(level)) {
+        throw std::invalid_argument("level does not fit a "
+            + std::to_string(W) + "x" + std::to_string(H) + " board");
+    }
+    wallSet = Inside;
+    bool hasPlayer = false;
+    for (unsigned int y = 0; y < level.height(); ++y) {
+        for (unsigned int x = 0; x < level.width(); ++x) {
+            std::size_t i = level.index(x, y);
+            unsigned int sq = square(x, y);
+            if (!level.isWall(i)) wallSet.reset(sq);
+            if (level.isGoal(i)) goalSet.set(sq);
+            if (level.hasBox(i)) boxSet.set(sq);
+            if (level.piece(i) == Board::Player) {
+                at = sq;
+                hasPlayer = true;
+            }
+        }
+    }
+    if (!hasPlayer) {
+        throw std::invalid_argument("level has no player");
+    }
+    Deadlock analysis(level);
+    if (analysis.everyBoxCounts()) {
+        for (unsigned int y = 0; y < level.height(); ++y) {
+            for (unsigned int x = 0; x < level.width(); ++x) {
+                std::size_t i = level.index(x, y);
+                if (analysis.isDeadSquare(i) && !level.isGoal(i)) {
+                    deadSet.set(square(x, y));
+                }
+            }
+        }
+    }
+}
+
+template <unsigned int W, unsigned int H>
+bool FixedBoard<W, H>::next(unsigned int square, Direction dir,
+ unsigned int& to) {
+    unsigned int x = square % W;
+    switch (dir) {
+        case Direction::Up:
+            to = square - W;
+            return square >= W;
+        case Direction::Down:
+            to = square + W;
+            return to < Squares;
+        case Direction::Left:
+            to = square - 1;
+            return x > 0;
+        case Direction::Right:
+            to = square + 1;
+            return x + 1 < W;
+    }
+    return false;
+}
+
+template <unsigned int W, unsigned int H>
+bool FixedBoard<W, H>::move(Direction dir) {
+    unsigned int to = 0, beyond = 0;
+    if (!next(at, dir, to) || wallSet.test(to)) return false;
+    if (boxSet.test(to)) {
+        if (!next(to, dir, beyond) || wallSet.test(beyond)
+         || boxSet.test(beyond)) {
+            return false;
+        }
+        boxSet.reset(to);
+        boxSet.set(beyond);
+        lostFlag |= deadSet.test(beyond);
+        ++pushCount;
+    }
+    at = to;
+    ++moveCount;
+    return true;
+}
+
+template <unsigned int W, unsigned int H>
+template <Direction D>
+constexpr typename FixedBoard<W, H>::Set FixedBoard<W, H>::shift(
+ const Set& set) {
+    if constexpr (D == Direction::Up) {
+        return set.template down<W>();
+    } else if constexpr (D == Direction::Down) {
+        return set.template up<W>() & Inside;
+    } else if constexpr (D == Direction::Left) {
+        return (set & NotLeft).template down<1>();
+    } else {
+        return (set & NotRight).template up<1>();
+    }
+}
+
+// Grows the player's square one step in every direction at a time until
+// nothing new is added, at most one round per square of the longest path
+template <unsigned int W, unsigned int H>
+typename FixedBoard<W, H>::Set FixedBoard<W, H>::reachable() const {
+    const Set open = Inside & ~(wallSet | boxSet);
+    Set seen;
+    seen.set(at);
+    for (;;) {
+        Set grown = (seen | shift<Direction::Up>(seen)
+            | shift<Direction::Down>(seen) | shift<Direction::Left>(seen)
+            | shift<Direction::Right>(seen)) & open;
+        if (grown == seen) return seen;
+        seen = grown;
+    }
+}
+
+// A box can go in dir when the square before it is reachable and the
+// square after it is open
+template <unsigned int W, unsigned int H>
+typename FixedBoard<W, H>::Set FixedBoard<W, H>::pushable(
+ Direction dir) const {
+    const Set reach = reachable();
+    const Set open = Inside & ~(wallSet | boxSet);
+    switch (dir) {
+        case Direction::Up:
+            return boxSet & shift<Direction::Up>(reach)
+                & shift<Direction::Down>(open);
+        case Direction::Down:
+            return boxSet & shift<Direction::Down>(reach)
+                & shift<Direction::Up>(open);
+        case Direction::Left:
+            return boxSet & shift<Direction::Left>(reach)
+                & shift<Direction::Right>(open);
+        case Direction::Right:
+            return boxSet & shift<Direction::Right>(reach)
+                & shift<Direction::Left>(open);
+    }
+    return Set();
+}
+
+}  // namespace SB
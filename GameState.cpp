@@ -0,0 +1,311 @@
+//  Copyright 2025 <Orbosa Igbinovia> [legal/copyright]
+#include "GameState.hpp"
+#include <algorithm>
+#include "Profiler.hpp"
+
+namespace SB {
+
+namespace {
+constexpr std::size_t kNever = static_cast<std::size_t>(-1);
+}  // namespace
+
+GameState::GameState()
+    : playerSquare(current.size()),
+      analysis(std::make_shared<Deadlock>(current)),
+      keys(std::make_shared<Zobrist>(current.size())), lostAt(kNever) {}
+
+GameState::GameState(const Board& level)
+    : start(level), current(level),
+      analysis(std::make_shared<Deadlock>(level)),
+      keys(std::make_shared<Zobrist>(level.size())) {
+    scan();
+}
+
+// Finds the player, boxes and goals of the current board
+void GameState::scan() {
+    playerSquare = current.size();
+    boxSquares.clear();
+    boxIndex.assign(current.size(), -1);
+    goals = 0;
+    onGoals = 0;
+    boxHash = 0;
+    for (unsigned int y = 0; y < current.height(); ++y) {
+        for (unsigned int x = 0; x < current.width(); ++x) {
+            std::size_t i = current.index(x, y);
+            if (current.piece(i) == Board::Player) {
+                playerSquare = i;
+            } else if (current.hasBox(i)) {
+                boxIndex[i] = static_cast<int32_t>(boxSquares.size());
+                boxSquares.push_back(static_cast<uint32_t>(i));
+                onGoals += current.isGoal(i);
+                boxHash ^= keys->box(i);
+            }
+            goals += current.isGoal(i);
+        }
+    }
+    lostAt = isLoaded() && analysis->isLost(current, scratch) ? 0 : kNever;
+}
+
+void GameState::checkDeadlock(std::size_t square) {
+    if (isDeadlocked()) {
+        return;  // once lost, a later push cannot win it back
+    }
+    SB_PROFILE_COUNT("deadlock_check");
+    // With spare boxes only a box stuck by this push calls for a recount
+    bool lost = analysis->afterPush(square, playerSquare,
+        [this](std::size_t sq) { return current.hasBox(sq); }, scratch)
+        && (analysis->everyBoxCounts() || analysis->isLost(current, scratch));
+    if (lost) {
+        lostAt = journalPos;
+    }
+}
+
+bool GameState::canMove(Direction dir) const {
+    if (!isLoaded()) {
+        return false;
+    }
+    // The wall border keeps every neighbour index inside the board
+    std::size_t next = playerSquare + current.step(dir);
+    if (current.hasBox(next)) {
+        return current.isFree(next + current.step(dir));
+    }
+    return current.isFree(next);
+}
+
+bool GameState::move(Direction dir) {
+    if (!canMove(dir)) {
+        return false;
+    }
+    std::size_t next = playerSquare + current.step(dir);
+    moveRecord record{dir, boxIndex[next]};
+
+    {
+        SB_PROFILE_SCOPE("history_push");
+        // A new move throws away anything that could have been redone
+        journal.resize(journalPos);
+        if (lostAt > journalPos) lostAt = kNever;
+        journal.push_back(record);
+        SB_PROFILE_COUNT("journal_push");
+        journalPos++;
+    }
+    applyMove(record);
+    return true;
+}
+
+bool GameState::moveAll(const std::vector<Direction>& path) {
+    std::size_t before = journalPos;
+    // The first move truncates the journal, keep what could be redone
+    std::vector<moveRecord> redoable(journal.begin() + before, journal.end());
+    std::size_t lost = lostAt;
+    for (std::size_t i = 0; i < path.size(); ++i) {
+        if (!move(path[i])) {
+            jumpTo(before);
+            journal.resize(before);
+            journal.insert(journal.end(), redoable.begin(), redoable.end());
+            lostAt = lost;
+            return false;
+        }
+        journal[journalPos - 1].chained = i > 0;
+    }
+    return !path.empty();
+}
+
+bool GameState::undo() {
+    if (journalPos == 0) {
+        return false;
+    }
+    do {
+        revertMove(journal[--journalPos]);
+    } while (journalPos > 0 && journal[journalPos].chained);
+    return true;
+}
+
+bool GameState::redo() {
+    if (journalPos == journal.size()) {
+        return false;
+    }
+    do {
+        applyMove(journal[journalPos++]);
+    } while (journalPos < journal.size() && journal[journalPos].chained);
+    return true;
+}
+
+void GameState::jumpTo(std::size_t position) {
+    position = std::min(position, journal.size());
+    while (journalPos > position) {
+        revertMove(journal[--journalPos]);
+    }
+    while (journalPos < position) {
+        applyMove(journal[journalPos++]);
+    }
+}
+
+void GameState::reset() {
+    current = start;
+    journal.clear();
+    journalPos = 0;
+    moveCount = 0;
+    scan();
+}
+
+std::size_t GameState::normalisedPlayer() const {
+    std::vector<uint8_t> seen(current.size(), 0);
+    std::vector<std::size_t> queue(1, playerSquare);
+    seen[playerSquare] = 1;
+    std::size_t smallest = playerSquare;
+    for (std::size_t head = 0; head < queue.size(); ++head) {
+        std::size_t sq = queue[head];
+        smallest = std::min(smallest, sq);
+        for (Direction dir : {Direction::Up, Direction::Down,
+         Direction::Left, Direction::Right}) {
+            std::size_t next = sq + current.step(dir);
+            if (!seen[next] && current.isFree(next)) {
+                seen[next] = 1;
+                queue.push_back(next);
+            }
+        }
+    }
+    return smallest;
+}
+
+uint64_t GameState::canonicalHash() const {
+    if (!isLoaded()) {
+        return boxHash;
+    }
+    return boxHash ^ keys->player(normalisedPlayer());
+}
+
+std::string GameState::packedKey() const {
+    if (!isLoaded()) {
+        return std::string();
+    }
+    std::size_t width = current.size() > 0xFFFF ? 4 : 2;
+    std::vector<uint32_t> squares(boxSquares);
+    std::sort(squares.begin(), squares.end());
+    squares.insert(squares.begin(),
+        static_cast<uint32_t>(normalisedPlayer()));
+
+    std::string key(width * squares.size(), '\0');
+    for (std::size_t i = 0; i < squares.size(); ++i) {
+        for (std::size_t b = 0; b < width; ++b) {
+            key[i * width + b] = static_cast<char>(
+                (squares[i] >> (8 * b)) & 0xFF);
+        }
+    }
+    return key;
+}
+
+bool GameState::restore(std::string_view key) {
+    std::size_t width = current.size() > 0xFFFF ? 4 : 2;
+    if (!isLoaded() || key.size() != width * (boxSquares.size() + 1)) {
+        return false;
+    }
+    std::vector<std::size_t> squares(boxSquares.size() + 1);
+    for (std::size_t i = 0; i < squares.size(); ++i) {
+        std::size_t sq = 0;
+        for (std::size_t b = 0; b < width; ++b) {
+            sq |= static_cast<std::size_t>(
+                static_cast<unsigned char>(key[i * width + b])) << (8 * b);
+        }
+        if (sq >= current.size() || current.isWall(sq)) {
+            return false;
+        }
+        squares[i] = sq;
+    }
+    for (std::size_t i = 1; i < squares.size(); ++i) {
+        // Boxes are sorted, distinct and not under the player
+        if (squares[i] == squares[0]
+         || (i > 1 && squares[i] <= squares[i - 1])) {
+            return false;
+        }
+    }
+
+    for (std::size_t i = 0; i < current.size(); ++i) {
+        current.setPiece(i, Board::Empty);
+    }
+    current.setPiece(squares[0], Board::Player);
+    for (std::size_t i = 1; i < squares.size(); ++i) {
+        current.setPiece(squares[i], Board::Box);
+    }
+    journal.clear();
+    journalPos = 0;
+    moveCount = 0;
+    scan();
+    return true;
+}
+
+Position GameState::position() const {
+    return Position{static_cast<uint32_t>(playerSquare), boxSquares,
+        moveCount};
+}
+
+void GameState::setPosition(const Position& target) {
+    for (uint32_t sq : boxSquares) {
+        current.setPiece(sq, Board::Empty);
+        boxIndex[sq] = -1;
+    }
+    current.setPiece(playerSquare, Board::Empty);
+
+    boxSquares = target.boxes;
+    onGoals = 0;
+    boxHash = 0;
+    for (std::size_t b = 0; b < boxSquares.size(); ++b) {
+        uint32_t sq = boxSquares[b];
+        current.setPiece(sq, Board::Box);
+        boxIndex[sq] = static_cast<int32_t>(b);
+        onGoals += current.isGoal(sq);
+        boxHash ^= keys->box(sq);
+    }
+    playerSquare = target.player;
+    current.setPiece(playerSquare, Board::Player);
+    moveCount = target.moves;
+    journal.clear();
+    journalPos = 0;
+    lostAt = analysis->isLost(current, scratch) ? 0 : kNever;
+}
+
+void GameState::moveBox(int32_t box, std::size_t from, std::size_t to) {
+    current.setPiece(from, Board::Empty);
+    current.setPiece(to, Board::Box);
+    boxIndex[from] = -1;
+    boxIndex[to] = box;
+    onGoals += current.isGoal(to);
+    onGoals -= current.isGoal(from);
+    boxSquares[box] = static_cast<uint32_t>(to);
+    boxHash ^= keys->box(from) ^ keys->box(to);
+}
+
+// Moves the player one step, dragging the recorded box along with it.
+// The move must already be known to be legal.
+void GameState::applyMove(const moveRecord& move) {
+    std::size_t next = playerSquare + current.step(move.dir);
+    if (move.box >= 0) {
+        // Move the box, the goal underneath stays in the static layer
+        moveBox(move.box, next, next + current.step(move.dir));
+    }
+    current.setPiece(playerSquare, Board::Empty);
+    current.setPiece(next, Board::Player);
+    playerSquare = next;
+    moveCount++;
+    if (move.box >= 0) {
+        checkDeadlock(boxSquares[move.box]);
+    }
+}
+
+void GameState::revertMove(const moveRecord& move) {
+    std::size_t back = playerSquare - current.step(move.dir);
+    current.setPiece(playerSquare, Board::Empty);
+    if (move.box >= 0) {
+        // Pull the box back onto the square the player is leaving
+        moveBox(move.box, playerSquare + current.step(move.dir),
+            playerSquare);
+    }
+    current.setPiece(back, Board::Player);
+    playerSquare = back;
+    moveCount--;
+    if (journalPos < lostAt) {
+        lostAt = kNever;
+    }
+}
+
+}  // namespace SB
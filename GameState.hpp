@@ -0,0 +1,128 @@
+//  Copyright 2025 <Orbosa Igbinovia> [legal/copyright]
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Board.hpp"
+#include "Deadlock.hpp"
+#include "Zobrist.hpp"
+
+namespace SB {
+//  journal entry for undoing and redoing moves in the game, only the
+//  step taken and the box it pushed are kept
+struct moveRecord {
+    Direction dir;
+    int32_t box;  //  index into boxes(), -1 when nothing was pushed
+    bool chained = false;  //  same undo step as the entry before it
+};
+
+//  Exact piece placement, boxes in the same order as GameState::boxes()
+struct Position {
+    uint32_t player = 0;
+    std::vector<uint32_t> boxes;
+    unsigned int moves = 0;
+};
+
+//  The rules of the game with no graphics, files or clocks. A GameState is
+//  a plain value: copying one forks the game, and a move only touches a
+//  few bytes of the board plus one journal entry. Squares are Board
+//  indices; use board().column() and board().row() for coordinates.
+class GameState {
+ public:
+    GameState();
+    explicit GameState(const Board& level);
+
+    const Board& board() const { return current; }
+    std::size_t player() const { return playerSquare; }
+    //  Square of every box, in the order they appear in the level
+    const std::vector<uint32_t>& boxes() const { return boxSquares; }
+    std::size_t goalCount() const { return goals; }
+    unsigned int boxesOnGoals() const { return onGoals; }
+    unsigned int moves() const { return moveCount; }
+    //  Every goal has a box, or every box is on a goal
+    bool isWon() const {
+        return onGoals == goals || onGoals == boxSquares.size();
+    }
+    //  No sequence of moves from here can win any more. Only undo helps.
+    bool isDeadlocked() const { return journalPos >= lostAt; }
+    //  Dead squares and freeze checks for this level, shared by copies
+    const Deadlock& deadlocks() const { return *analysis; }
+    //  Zobrist hash of the exact position, kept up to date by every move.
+    //  Box order does not matter, only which squares hold a box.
+    uint64_t hash() const {
+        return isLoaded() ? boxHash ^ keys->player(playerSquare) : boxHash;
+    }
+    //  Same, with the player moved to the smallest square it can walk to,
+    //  so positions that differ only by walking hash alike. Costs a flood
+    //  fill of the player's region.
+    uint64_t canonicalHash() const;
+    //  Canonical position as bytes, usable as a hash table key: the
+    //  normalised player square, then the box squares in ascending order,
+    //  little endian, 2 bytes each (4 on boards over 65535 squares)
+    std::string packedKey() const;
+    //  Puts the pieces where a packedKey from the same level says and
+    //  clears the journal. False, with nothing changed, if it does not fit.
+    bool restore(std::string_view key);
+    Position position() const;
+    //  Moves the pieces to a Position taken from the same level and clears
+    //  the journal. Costs O(boxes) plus one deadlock scan.
+    void setPosition(const Position& position);
+    //  Player is on the board (false for a default constructed state)
+    bool isLoaded() const { return playerSquare < current.size(); }
+
+    bool canMove(Direction dir) const;
+    //  Takes one step, pushing a box if there is one. Blocked moves return
+    //  false and are not journaled.
+    bool move(Direction dir);
+    //  Plays a whole path as one undo step. If any move is blocked the
+    //  moves already made are taken back, the redo history is left as it
+    //  was and false is returned.
+    bool moveAll(const std::vector<Direction>& path);
+    //  Takes back (or replays) one undo step: a single move or a whole
+    //  path from moveAll
+    bool undo();
+    bool redo();
+    //  Undo or redo until the given number of journal moves are applied
+    void jumpTo(std::size_t position);
+    //  Back to the starting position with an empty journal
+    void reset();
+
+    const std::vector<moveRecord>& history() const { return journal; }
+    std::size_t historyPosition() const { return journalPos; }
+    //  Reserves journal space up front so long runs never reallocate
+    void reserveHistory(std::size_t moves) { journal.reserve(moves); }
+
+ private:
+    Board start;
+    Board current;
+    std::size_t playerSquare;
+    std::vector<uint32_t> boxSquares;
+    //  Board square -> index into boxSquares, -1 where there is no box
+    std::vector<int32_t> boxIndex;
+    std::size_t goals = 0;
+    unsigned int onGoals = 0;
+    unsigned int moveCount = 0;
+    std::vector<moveRecord> journal;
+    std::size_t journalPos = 0;  //  moves of the journal currently applied
+    std::shared_ptr<const Deadlock> analysis;
+    std::shared_ptr<const Zobrist> keys;
+    uint64_t boxHash = 0;  //  XOR of the box keys
+    //  Journal position where the game was first lost, npos if it is not
+    std::size_t lostAt;
+    //  Reused by every deadlock check so a push does not allocate
+    Deadlock::Scratch scratch;
+
+    void scan();
+    //  Smallest square the player can walk to without pushing
+    std::size_t normalisedPlayer() const;
+    //  Called after a push onto square
+    void checkDeadlock(std::size_t square);
+    void moveBox(int32_t box, std::size_t from, std::size_t to);
+    void applyMove(const moveRecord& move);
+    void revertMove(const moveRecord& move);
+};
+
+}  // namespace SB
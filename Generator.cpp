@@ -0,0 +1,143 @@
+//  Copyright 2025 <Orbosa Igbinovia> [legal/copyright]
+#include "Generator.hpp"
+#include <random>
+#include <stdexcept>
+#include "ThreadPool.hpp"
+
+namespace SB {
+
+namespace {
+constexpr Direction kDirections[4] = {Direction::Up, Direction::Down,
+    Direction::Left, Direction::Right};
+
+// splitmix64, spreads neighbouring seeds far apart
+uint64_t mix(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+// Walls the outer ring and a random share of the inside, then walls off
+// everything but the largest connected area. Returns that area's squares.
+std::vector<std::size_t> buildRoom(Board& board, double wallDensity,
+ std::mt19937_64& rng) {
+    const uint64_t threshold = static_cast<uint64_t>(wallDensity * 1000);
+    for (unsigned int y = 0; y < board.height(); ++y) {
+        for (unsigned int x = 0; x < board.width(); ++x) {
+            bool edge = x == 0 || y == 0 || x + 1 == board.width()
+                || y + 1 == board.height();
+            board.setTile(x, y, edge || rng() % 1000 < threshold ? '#' : '.');
+        }
+    }
+
+    std::vector<uint8_t> seen(board.size(), 0);
+    std::vector<std::size_t> best, area;
+    for (std::size_t start = 0; start < board.size(); ++start) {
+        if (seen[start] || board.isWall(start)) continue;
+        area.assign(1, start);
+        seen[start] = 1;
+        for (std::size_t head = 0; head < area.size(); ++head) {
+            for (Direction dir : kDirections) {
+                std::size_t next = area[head] + board.step(dir);
+                if (!seen[next] && !board.isWall(next)) {
+                    seen[next] = 1;
+                    area.push_back(next);
+                }
+            }
+        }
+        if (area.size() > best.size()) best.swap(area);
+    }
+
+    std::vector<uint8_t> keep(board.size(), 0);
+    for (std::size_t sq : best) keep[sq] = 1;
+    for (std::size_t i = 0; i < board.size(); ++i) {
+        if (!keep[i]) board.setTerrain(i, Board::Wall);
+    }
+    return best;
+}
+
+// Plays backwards from the solved position: each step walks the player,
+// and when a box is behind it, usually drags the box along. Returns the
+// pulls made and leaves the player square in player.
+unsigned int scramble(Board& board, std::size_t& player, unsigned int pulls,
+ std::mt19937_64& rng) {
+    unsigned int made = 0;
+    std::size_t budget = 50 * static_cast<std::size_t>(pulls) + 100;
+    for (std::size_t s = 0; s < budget && made < pulls; ++s) {
+        Direction dir = kDirections[rng() % 4];
+        std::size_t next = player + board.step(dir);
+        if (!board.isFree(next)) continue;
+        std::size_t behind = player - board.step(dir);
+        board.setPiece(player, Board::Empty);
+        if (board.hasBox(behind) && rng() % 4 != 0) {
+            board.setPiece(behind, Board::Empty);
+            board.setPiece(player, Board::Box);
+            ++made;
+        }
+        board.setPiece(next, Board::Player);
+        player = next;
+    }
+    // Walk off a goal if the scramble stopped on one
+    for (std::size_t s = 0; s < budget && board.isGoal(player); ++s) {
+        std::size_t next = player + board.step(kDirections[rng() % 4]);
+        if (board.isFree(next)) {
+            board.setPiece(player, Board::Empty);
+            board.setPiece(next, Board::Player);
+            player = next;
+        }
+    }
+    return made;
+}
+}  // namespace
+
+GeneratedLevel generateLevel(const GeneratorOptions& options, uint64_t seed) {
+    if (options.width < 3 || options.height < 3 || options.boxes == 0
+     || static_cast<std::size_t>(options.width - 2) * (options.height - 2)
+        < options.boxes + 1) {
+        throw std::invalid_argument("level too small for its boxes");
+    }
+    std::mt19937_64 rng(seed);
+    for (unsigned int attempt = 0; attempt < options.attempts; ++attempt) {
+        Board board(options.width, options.height);
+        std::vector<std::size_t> floor =
+            buildRoom(board, options.wallDensity, rng);
+        if (floor.size() < options.boxes + 2) continue;
+
+        // Solved position: boxes on the goals, the player somewhere else
+        for (std::size_t i = 0; i <= options.boxes; ++i) {
+            std::swap(floor[i], floor[i + rng() % (floor.size() - i)]);
+        }
+        for (unsigned int b = 0; b < options.boxes; ++b) {
+            board.setTerrain(floor[b], Board::Goal);
+            board.setPiece(floor[b], Board::Box);
+        }
+        std::size_t player = floor[options.boxes];
+        board.setPiece(player, Board::Player);
+
+        unsigned int pulls = scramble(board, player, options.pulls, rng);
+        bool boxOnGoal = false;
+        for (unsigned int b = 0; b < options.boxes; ++b) {
+            boxOnGoal |= board.hasBox(floor[b]);
+        }
+        if (boxOnGoal || board.isGoal(player)) continue;
+        return GeneratedLevel{board, seed, pulls};
+    }
+    throw std::runtime_error("no level found in "
+        + std::to_string(options.attempts) + " attempts");
+}
+
+std::vector<GeneratedLevel> generateLevels(const GeneratorOptions& options,
+ std::size_t count) {
+    std::vector<GeneratedLevel> levels(count);
+    ThreadPool pool(options.threads);
+    for (std::size_t i = 0; i < count; ++i) {
+        pool.submit([&options, &levels, i] {
+            levels[i] = generateLevel(options, mix(options.seed + i));
+        });
+    }
+    pool.wait();
+    return levels;
+}
+
+}  // namespace SB
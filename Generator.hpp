@@ -0,0 +1,50 @@
+//  Copyright 2025 <Orbosa Igbinovia> [legal/copyright]
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Board.hpp"
+
+namespace SB {
+
+struct GeneratorOptions {
+    //  Level size including the outer wall, as in the .lvl header
+    unsigned int width = 10;
+    unsigned int height = 10;
+    unsigned int boxes = 3;
+    //  Difficulty: box pulls made while scrambling the solved position.
+    //  More pulls drag the boxes further from their goals.
+    unsigned int pulls = 30;
+    //  Share of the inside squares turned into wall before the room is
+    //  trimmed to its largest connected area
+    double wallDensity = 0.15;
+    //  Rooms tried per level before giving up
+    unsigned int attempts = 50;
+    uint64_t seed = 1;
+    unsigned int threads = 0;  //  0 means one per hardware thread
+};
+
+struct GeneratedLevel {
+    Board level;
+    uint64_t seed = 0;  //  generateLevel(options, seed) makes it again
+    //  Pulls in the scramble; playing them back as pushes solves the
+    //  level, so this bounds the pushes an optimal solution needs
+    unsigned int pulls = 0;
+};
+
+//  Builds a random room, puts every box on a goal and then plays the game
+//  backwards: the player walks and pulls boxes, each pull being a push in
+//  reverse. Whatever position that reaches can be pushed back, so every
+//  level is solvable. No box is left on a goal and the player never ends
+//  on one (the .lvl format cannot show it). Throws std::invalid_argument
+//  for options no room can satisfy and std::runtime_error when every
+//  attempt fails.
+GeneratedLevel generateLevel(const GeneratorOptions& options, uint64_t seed);
+
+//  count levels spread over a ThreadPool. Level i uses a seed derived from
+//  options.seed and i only, so the output does not depend on the number
+//  of threads or the order they finish in.
+std::vector<GeneratedLevel> generateLevels(const GeneratorOptions& options,
+    std::size_t count);
+
+}  // namespace SB
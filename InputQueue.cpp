@@ -0,0 +1,94 @@
+//  Copyright 2025 <Orbosa Igbinovia> [legal/copyright]
+#include "InputQueue.hpp"
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+namespace SB {
+
+InputQueue::InputQueue(Clock::duration step, std::size_t perStep,
+ unsigned int maxSteps)
+    : step(step), perStep(perStep), maxSteps(maxSteps) {
+    if (step <= Clock::duration::zero() || perStep == 0 || maxSteps == 0) {
+        throw std::invalid_argument("input queue needs a positive step");
+    }
+}
+
+void InputQueue::push(const InputEvent& event) {
+    // An idle clock is not owed any steps, the first press starts it
+    if (queue.empty()) {
+        nextStep = std::max(nextStep, event.at);
+    }
+    queue.push_back(event);
+}
+
+std::size_t InputQueue::update(Clock::time_point now,
+ const std::function<void(const InputEvent&)>& apply) {
+    std::size_t applied = 0;
+    unsigned int steps = 0;
+    while (!queue.empty() && nextStep <= now && steps < maxSteps) {
+        for (std::size_t n = 0; n < perStep && !queue.empty(); ++n) {
+            InputEvent event = queue.front();
+            queue.pop_front();
+            apply(event);
+            unseen.push_back(event.at);
+            ++applied;
+        }
+        nextStep += step;
+        ++steps;
+    }
+    if (steps == maxSteps && nextStep <= now) {
+        nextStep = now + step;  // fell behind, start the steps over
+    }
+    return applied;
+}
+
+InputQueue::Clock::duration InputQueue::untilStep(Clock::time_point now)
+ const {
+    if (queue.empty()) {
+        return Clock::duration::max();
+    }
+    return std::max(Clock::duration::zero(), nextStep - now);
+}
+
+std::size_t InputQueue::presented(Clock::time_point shown) {
+    for (Clock::time_point at : unseen) {
+        Clock::duration latency = shown - at;
+        if (latencies.size() < MaxSamples) {
+            latencies.push_back(latency);
+        } else {
+            latencies[oldest] = latency;
+            oldest = (oldest + 1) % MaxSamples;
+        }
+    }
+    std::size_t recorded = unseen.size();
+    unseen.clear();
+    return recorded;
+}
+
+InputQueue::Clock::duration InputQueue::percentile(double fraction) const {
+    if (latencies.empty()) {
+        return Clock::duration::zero();
+    }
+    std::vector<Clock::duration> sorted = latencies;
+    std::size_t i = std::min(sorted.size() - 1,
+        static_cast<std::size_t>(fraction * sorted.size()));
+    std::nth_element(sorted.begin(), sorted.begin() + i, sorted.end());
+    return sorted[i];
+}
+
+std::string InputQueue::summary() const {
+    if (latencies.empty()) {
+        return "";
+    }
+    auto ms = [this](double fraction) {
+        return std::chrono::duration<double, std::milli>(
+            percentile(fraction)).count();
+    };
+    std::ostringstream out;
+    out << "input p50 " << ms(0.5) << "ms, p95 " << ms(0.95) << "ms, p99 "
+        << ms(0.99) << "ms (" << latencies.size() << ")";
+    return out.str();
+}
+
+}  // namespace SB
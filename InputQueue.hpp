@@ -0,0 +1,84 @@
+//  Copyright 2025 <Orbosa Igbinovia> [legal/copyright]
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <string>
+#include <vector>
+#include "Board.hpp"
+
+namespace SB {
+
+//  What a queued input asks the game to do
+enum class InputAction : uint8_t { Move, Undo, Redo, Reset, Click, Deselect };
+
+struct InputEvent {
+    InputAction action = InputAction::Move;
+    Direction dir = Direction::Up;  //  for Move
+    unsigned int x = 0;  //  tile, for Click
+    unsigned int y = 0;
+    //  When the window handed the event over (SFML events carry no time
+    //  of their own)
+    std::chrono::steady_clock::time_point at;
+};
+
+//  Game input between the window and the rules. The window loop stamps
+//  and pushes events as it reads them, and update() applies them on a
+//  fixed step: at most perStep events per step, so presses that piled up
+//  behind a slow frame come out one step apart instead of in one burst,
+//  and at most maxSteps steps per call, after which the step clock starts
+//  over from now rather than racing to catch up. A press arriving while
+//  idle is applied on the next update, without waiting for a step.
+//
+//  Drawing stays with the caller and runs at its own pace. After a frame
+//  is on screen, presented() records the input-to-display latency of
+//  every event applied since the last one. Nothing is interpolated: the
+//  board is drawn in whole tiles, so a frame shows the latest step.
+class InputQueue {
+ public:
+    using Clock = std::chrono::steady_clock;
+    //  Latencies kept for the percentiles, the most recent win
+    static constexpr std::size_t MaxSamples = 4096;
+
+    explicit InputQueue(Clock::duration step = std::chrono::milliseconds(8),
+        std::size_t perStep = 1, unsigned int maxSteps = 2);
+
+    void push(const InputEvent& event);
+    std::size_t pending() const { return queue.size(); }
+    //  Drops everything still queued, e.g. when the level changes
+    void clear() { queue.clear(); }
+
+    //  Runs the steps due by now, passing each event to apply in the order
+    //  it was pushed. Returns the number applied.
+    std::size_t update(Clock::time_point now,
+        const std::function<void(const InputEvent&)>& apply);
+    //  How long until update() has something to do: zero when a step is
+    //  due, Clock::duration::max() when nothing is queued
+    Clock::duration untilStep(Clock::time_point now) const;
+
+    //  A frame showing every event applied so far reached the screen at
+    //  shown. Returns the number of latencies recorded.
+    std::size_t presented(Clock::time_point shown);
+    //  No frame was drawn: the events applied since the last one did not
+    //  change the screen, so they are dropped without a latency
+    void unchanged() { unseen.clear(); }
+    std::size_t samples() const { return latencies.size(); }
+    //  Latency of the given fraction of events, from the kept samples
+    Clock::duration percentile(double fraction) const;
+    //  One line of percentiles for the overlay, empty before any sample
+    std::string summary() const;
+
+ private:
+    Clock::duration step;
+    std::size_t perStep;
+    unsigned int maxSteps;
+    std::deque<InputEvent> queue;
+    Clock::time_point nextStep;
+    std::vector<Clock::time_point> unseen;  //  applied, not yet shown
+    std::vector<Clock::duration> latencies;  //  ring of MaxSamples
+    std::size_t oldest = 0;
+};
+
+}  // namespace SB
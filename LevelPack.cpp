@@ -0,0 +1,216 @@
+//  Copyright 2025 <Orbosa Igbinovia> [legal/copyright]
+#include "LevelPack.hpp"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+
+namespace SB {
+
+namespace {
+constexpr char kMagic[4] = {'S', 'B', 'P', 'K'};
+constexpr std::size_t kHeaderSize = 16;
+constexpr std::size_t kRecordHeader = 4;
+
+uint64_t readLittle(const unsigned char* p, int bytes) {
+    uint64_t value = 0;
+    for (int i = bytes - 1; i >= 0; --i) {
+        value = (value << 8) | p[i];
+    }
+    return value;
+}
+
+void writeLittle(std::string& out, uint64_t value, int bytes) {
+    for (int i = 0; i < bytes; ++i) {
+        out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+std::size_t packedBytes(std::size_t tiles) {
+    return (tiles * 3 + 7) / 8;
+}
+
+uint8_t encodeTile(const Board& board, std::size_t i) {
+    bool goal = board.isGoal(i);
+    if (board.piece(i) == Board::Player) return goal ? 6 : 5;
+    if (board.hasBox(i)) return goal ? 4 : 3;
+    if (board.isWall(i)) return 1;
+    return goal ? 2 : 0;
+}
+}  // namespace
+
+LevelPack::LevelPack(const std::string& filename) {
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Unable to open file: " + filename);
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || info.st_size < 0
+     || static_cast<std::size_t>(info.st_size) < kHeaderSize) {
+        ::close(fd);
+        throw std::runtime_error("Not a level pack: " + filename);
+    }
+    length = static_cast<std::size_t>(info.st_size);
+    void* mapped = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);  // the mapping keeps the file alive
+    if (mapped == MAP_FAILED) {
+        throw std::runtime_error("Unable to map file: " + filename);
+    }
+    data = static_cast<const unsigned char*>(mapped);
+
+    if (std::memcmp(data, kMagic, sizeof(kMagic)) != 0
+     || readLittle(data + 4, 2) != VERSION) {
+        unmap();
+        throw std::runtime_error("Not a level pack: " + filename);
+    }
+    count = readLittle(data + 8, 4);
+    if ((length - kHeaderSize) / 8 < count + 1) {
+        unmap();
+        throw std::runtime_error("Truncated level pack: " + filename);
+    }
+}
+
+LevelPack::~LevelPack() {
+    unmap();
+}
+
+LevelPack::LevelPack(LevelPack&& other) noexcept
+    : data(std::exchange(other.data, nullptr)),
+      length(std::exchange(other.length, 0)),
+      count(std::exchange(other.count, 0)) {}
+
+LevelPack& LevelPack::operator=(LevelPack&& other) noexcept {
+    if (this != &other) {
+        unmap();
+        data = std::exchange(other.data, nullptr);
+        length = std::exchange(other.length, 0);
+        count = std::exchange(other.count, 0);
+    }
+    return *this;
+}
+
+void LevelPack::unmap() {
+    if (data != nullptr) {
+        ::munmap(const_cast<unsigned char*>(data), length);
+        data = nullptr;
+    }
+}
+
+std::size_t LevelPack::size() const { return count; }
+
+// Offset table lookup, checked against the file so a corrupt pack throws
+// instead of reading past the mapping
+const unsigned char* LevelPack::record(std::size_t level) const {
+    if (level >= count) {
+        throw std::out_of_range("Level " + std::to_string(level)
+            + " is not in the pack");
+    }
+    const unsigned char* table = data + kHeaderSize;
+    uint64_t begin = readLittle(table + 8 * level, 8);
+    uint64_t end = readLittle(table + 8 * (level + 1), 8);
+    if (begin > end || end > length || end - begin < kRecordHeader) {
+        throw std::runtime_error("Corrupt level pack record");
+    }
+    const unsigned char* p = data + begin;
+    std::size_t tiles = readLittle(p, 2) * readLittle(p + 2, 2);
+    if (end - begin < kRecordHeader + packedBytes(tiles)) {
+        throw std::runtime_error("Corrupt level pack record");
+    }
+    return p;
+}
+
+unsigned int LevelPack::width(std::size_t level) const {
+    return static_cast<unsigned int>(readLittle(record(level), 2));
+}
+
+unsigned int LevelPack::height(std::size_t level) const {
+    return static_cast<unsigned int>(readLittle(record(level) + 2, 2));
+}
+
+Board LevelPack::level(std::size_t level) const {
+    const unsigned char* p = record(level);
+    unsigned int w = static_cast<unsigned int>(readLittle(p, 2));
+    unsigned int h = static_cast<unsigned int>(readLittle(p + 2, 2));
+    const unsigned char* bits = p + kRecordHeader;
+    std::size_t last = packedBytes(static_cast<std::size_t>(w) * h) - 1;
+
+    Board board(w, h);
+    std::size_t k = 0;
+    for (unsigned int y = 0; y < h; ++y) {
+        for (unsigned int x = 0; x < w; ++x, ++k) {
+            std::size_t bit = k * 3, byte = bit / 8;
+            unsigned int window = bits[byte];
+            if (byte < last) window |= bits[byte + 1] << 8;
+            unsigned int code = (window >> (bit % 8)) & 0x7;
+
+            std::size_t i = board.index(x, y);
+            bool goal = code == 2 || code == 4 || code == 6;
+            board.setTerrain(i, code == 1 ? Board::Wall
+                : goal ? Board::Goal : Board::Floor);
+            board.setPiece(i, code == 3 || code == 4 ? Board::Box
+                : code == 5 || code == 6 ? Board::Player : Board::Empty);
+        }
+    }
+    return board;
+}
+
+bool LevelPack::isPack(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    char magic[sizeof(kMagic)] = {};
+    file.read(magic, sizeof(magic));
+    return file && std::memcmp(magic, kMagic, sizeof(kMagic)) == 0;
+}
+
+void LevelPack::write(const std::string& filename,
+ const std::vector<Board>& levels) {
+    std::string records;
+    std::vector<uint64_t> offsets;
+    uint64_t base = kHeaderSize + 8 * (levels.size() + 1);
+    for (const Board& board : levels) {
+        if (board.width() > 0xFFFF || board.height() > 0xFFFF) {
+            throw std::length_error("Level is too large for a level pack");
+        }
+        offsets.push_back(base + records.size());
+        writeLittle(records, board.width(), 2);
+        writeLittle(records, board.height(), 2);
+
+        std::size_t start = records.size();
+        records.append(packedBytes(
+            static_cast<std::size_t>(board.width()) * board.height()), '\0');
+        std::size_t k = 0;
+        for (unsigned int y = 0; y < board.height(); ++y) {
+            for (unsigned int x = 0; x < board.width(); ++x, ++k) {
+                uint8_t code = encodeTile(board, board.index(x, y));
+                for (int b = 0; b < 3; ++b) {
+                    if (code & (1 << b)) {
+                        std::size_t bit = k * 3 + b;
+                        records[start + bit / 8] = static_cast<char>(
+                            records[start + bit / 8] | (1 << (bit % 8)));
+                    }
+                }
+            }
+        }
+    }
+    offsets.push_back(base + records.size());
+
+    std::string header(kMagic, sizeof(kMagic));
+    writeLittle(header, VERSION, 2);
+    writeLittle(header, 0, 2);
+    writeLittle(header, levels.size(), 4);
+    writeLittle(header, 0, 4);
+    for (uint64_t offset : offsets) {
+        writeLittle(header, offset, 8);
+    }
+
+    std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+    out << header << records;
+    if (!out) {
+        throw std::runtime_error("Unable to write file: " + filename);
+    }
+}
+
+}  // namespace SB
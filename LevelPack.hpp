@@ -0,0 +1,51 @@
+//  Copyright 2025 <Orbosa Igbinovia> [legal/copyright]
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Board.hpp"
+
+namespace SB {
+
+//  Binary file holding many levels, read through mmap.
+//
+//  Layout (little endian):
+//    "SBPK"  u16 version  u16 reserved  u32 levelCount  u32 reserved
+//    u64 offsets[levelCount + 1]   start of each record, then end of file
+//    records: u16 width  u16 height  tiles packed 3 bits each, row-major
+//
+//  Tile codes: 0 floor, 1 wall, 2 goal, 3 box, 4 box on goal,
+//  5 player, 6 player on goal.
+class LevelPack {
+ public:
+    static constexpr uint16_t VERSION = 1;
+
+    explicit LevelPack(const std::string& filename);
+    ~LevelPack();
+    LevelPack(const LevelPack&) = delete;
+    LevelPack& operator=(const LevelPack&) = delete;
+    LevelPack(LevelPack&& other) noexcept;
+    LevelPack& operator=(LevelPack&& other) noexcept;
+
+    std::size_t size() const;
+    unsigned int width(std::size_t level) const;
+    unsigned int height(std::size_t level) const;
+    //  Decodes one level straight out of the mapping
+    Board level(std::size_t level) const;
+
+    //  True when the file starts with the pack magic
+    static bool isPack(const std::string& filename);
+    static void write(const std::string& filename,
+        const std::vector<Board>& levels);
+
+ private:
+    const unsigned char* data = nullptr;
+    std::size_t length = 0;
+    std::size_t count = 0;
+
+    const unsigned char* record(std::size_t level) const;
+    void unmap();
+};
+
+}  // namespace SB
@@ -0,0 +1,337 @@
+//  Copyright 2025 <Orbosa Igbinovia> [legal/copyright]
+#include "LevelParser.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+
+namespace SB {
+
+namespace {
+// Walks the buffer one line at a time without copying
+class LineCursor {
+ public:
+    explicit LineCursor(std::string_view text) : text(text) {}
+
+    bool next(std::string_view& line) {
+        if (pos >= text.size()) return false;
+        std::size_t end = text.find('\n', pos);
+        if (end == std::string_view::npos) end = text.size();
+        line = text.substr(pos, end - pos);
+        pos = end + 1;
+        ++number;
+        // Trailing whitespace (and the '\r' of CRLF files) never matters
+        while (!line.empty() && (line.back() == '\r' || line.back() == ' '
+         || line.back() == '\t')) {
+            line.remove_suffix(1);
+        }
+        return true;
+    }
+    // Steps back over the line just read
+    void unread(std::string_view line) {
+        pos = static_cast<std::size_t>(line.data() - text.data());
+        --number;
+    }
+    std::size_t line() const { return number; }
+    std::size_t remaining() const {
+        return pos < text.size() ? text.size() - pos : 0;
+    }
+
+ private:
+    std::string_view text;
+    std::size_t pos = 0;
+    std::size_t number = 0;
+};
+
+std::string_view trimLeft(std::string_view line) {
+    std::size_t first = line.find_first_not_of(" \t");
+    return first == std::string_view::npos ? std::string_view()
+        : line.substr(first);
+}
+
+// "height width" with nothing else on the line
+bool readHeader(std::string_view line, unsigned int& height,
+ unsigned int& width) {
+    unsigned long long values[2] = {0, 0};
+    std::size_t i = 0;
+    for (unsigned long long& value : values) {
+        while (i < line.size() && (line[i] == ' ' || line[i] == '\t')) ++i;
+        std::size_t digits = 0;
+        while (i < line.size() && line[i] >= '0' && line[i] <= '9') {
+            value = value * 10 + static_cast<unsigned>(line[i++] - '0');
+            if (++digits > 9) return false;
+        }
+        if (digits == 0) return false;
+    }
+    if (i != line.size()) return false;
+    height = static_cast<unsigned int>(values[0]);
+    width = static_cast<unsigned int>(values[1]);
+    return true;
+}
+
+bool isXsbRowStart(char c) {
+    return c == '#' || c == '-' || c == '_';
+}
+
+// Tile character -> static and dynamic layer. False for unknown glyphs.
+bool courseTile(char c, uint8_t& terrain, uint8_t& piece) {
+    terrain = Board::Floor;
+    piece = Board::Empty;
+    switch (c) {
+        case '#': terrain = Board::Wall; return true;
+        case '.': return true;
+        case 'a': terrain = Board::Goal; return true;
+        case 'A': piece = Board::Box; return true;
+        case '1': terrain = Board::Goal; piece = Board::Box; return true;
+        case '@': piece = Board::Player; return true;
+        default: return false;
+    }
+}
+
+bool xsbTile(char c, uint8_t& terrain, uint8_t& piece) {
+    terrain = Board::Floor;
+    piece = Board::Empty;
+    switch (c) {
+        case '#': terrain = Board::Wall; return true;
+        case ' ': case '-': case '_': return true;
+        case '.': terrain = Board::Goal; return true;
+        case '$': piece = Board::Box; return true;
+        case '*': terrain = Board::Goal; piece = Board::Box; return true;
+        case '@': piece = Board::Player; return true;
+        case '+': terrain = Board::Goal; piece = Board::Player; return true;
+        default: return false;
+    }
+}
+
+class Parser {
+ public:
+    Parser(std::string_view text, const ParseOptions& options)
+        : cursor(text), options(options) {}
+
+    ParseResult run() {
+        std::string_view line;
+        while (!result.error && cursor.next(line)) {
+            std::string_view body = trimLeft(line);
+            unsigned int height, width;
+            if (body.empty() || body[0] == ';') {
+                continue;
+            } else if (readHeader(body, height, width)) {
+                courseLevel(height, width);
+            } else if (isXsbRowStart(body[0])) {
+                cursor.unread(line);
+                xsbLevel();
+            }
+            // Anything else between levels is a title or metadata line
+        }
+        return std::move(result);
+    }
+
+ private:
+    LineCursor cursor;
+    const ParseOptions& options;
+    ParseResult result;
+
+    void fail(std::size_t line, std::size_t column, std::string message) {
+        if (!result.error) {
+            result.error = ParseError{line, column, std::move(message)};
+        }
+    }
+
+    // Places one tile, refusing a second player
+    bool place(Board& board, unsigned int x, unsigned int y, uint8_t terrain,
+     uint8_t piece, bool& havePlayer, std::size_t line) {
+        if (piece == Board::Player) {
+            if (havePlayer) {
+                fail(line, x + 1, "level has more than one player");
+                return false;
+            }
+            havePlayer = true;
+        }
+        std::size_t i = board.index(x, y);
+        board.setTerrain(i, terrain);
+        board.setPiece(i, piece);
+        return true;
+    }
+
+    void courseLevel(unsigned int height, unsigned int width) {
+        std::size_t header = cursor.line();
+        if (height == 0 || width == 0) {
+            fail(header, 1, "level size must be at least 1x1");
+            return;
+        }
+        // Every tile needs a byte of input, so a lying header fails here
+        // instead of allocating a huge board
+        if (static_cast<unsigned long long>(height) * width
+         > cursor.remaining()) {
+            fail(header, 1, "header says " + std::to_string(height) + "x"
+                + std::to_string(width) + " but the file is too short");
+            return;
+        }
+
+        Board board(width, height);
+        bool havePlayer = false;
+        std::string_view row;
+        for (unsigned int y = 0; y < height; ++y) {
+            if (!cursor.next(row)) {
+                fail(cursor.line() + 1, 1, "expected " + std::to_string(height)
+                    + " rows, found " + std::to_string(y));
+                return;
+            }
+            for (unsigned int x = 0; x < width && x < row.size(); ++x) {
+                uint8_t terrain, piece;
+                if (!courseTile(row[x], terrain, piece)) {
+                    fail(cursor.line(), x + 1,
+                        std::string("unexpected character '") + row[x] + "'");
+                    return;
+                }
+                if (!place(board, x, y, terrain, piece, havePlayer,
+                 cursor.line())) {
+                    return;
+                }
+            }
+            if (row.size() != width) {
+                std::size_t column = std::min<std::size_t>(row.size(), width);
+                fail(cursor.line(), column + 1,
+                    "row has " + std::to_string(row.size())
+                    + " tiles, expected " + std::to_string(width));
+                return;
+            }
+        }
+        finish(std::move(board), header);
+    }
+
+    void xsbLevel() {
+        std::vector<std::string_view> rows;
+        std::string_view line;
+        std::size_t first = cursor.line() + 1;
+        while (cursor.next(line)) {
+            std::string_view body = trimLeft(line);
+            if (body.empty() || !isXsbRowStart(body[0])) {
+                cursor.unread(line);
+                break;
+            }
+            rows.push_back(line);
+        }
+
+        std::size_t width = 0;
+        for (std::string_view row : rows) width = std::max(width, row.size());
+        // Short rows are padded with floor outside the walls
+        Board board(static_cast<unsigned int>(width),
+            static_cast<unsigned int>(rows.size()));
+        bool havePlayer = false;
+        for (unsigned int y = 0; y < rows.size(); ++y) {
+            for (unsigned int x = 0; x < rows[y].size(); ++x) {
+                uint8_t terrain, piece;
+                if (!xsbTile(rows[y][x], terrain, piece)) {
+                    fail(first + y, x + 1, std::string("unexpected character '")
+                        + rows[y][x] + "'");
+                    return;
+                }
+                if (!place(board, x, y, terrain, piece, havePlayer,
+                 first + y)) {
+                    return;
+                }
+            }
+        }
+        finish(std::move(board), first);
+    }
+
+    void finish(Board board, std::size_t line) {
+        std::size_t players = 0, boxes = 0, goals = 0;
+        for (std::size_t i = 0; i < board.size(); ++i) {
+            players += board.piece(i) == Board::Player;
+            boxes += board.hasBox(i);
+            goals += board.isGoal(i);
+        }
+        if (players == 0) {
+            fail(line, 1, "level has no player");
+        } else if (boxes == 0 || goals == 0) {
+            fail(line, 1, "level needs at least one box and one goal");
+        } else if (options.requireMatchingCounts && boxes != goals) {
+            fail(line, 1, "level has " + std::to_string(boxes)
+                + " boxes but " + std::to_string(goals) + " goals");
+        } else {
+            result.levels.push_back(std::move(board));
+        }
+    }
+};
+}  // namespace
+
+LevelError::LevelError(const ParseError& error)
+    : std::runtime_error("line " + std::to_string(error.line) + ", column "
+        + std::to_string(error.column) + ": " + error.message),
+      detail(error) {}
+
+std::size_t LevelError::line() const { return detail.line; }
+std::size_t LevelError::column() const { return detail.column; }
+
+ParseResult parseLevels(std::string_view text, const ParseOptions& options) {
+    return Parser(text, options).run();
+}
+
+ParseResult readLevels(const std::string& filename,
+ const ParseOptions& options) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Unable to open file: " + filename);
+    }
+    std::string text((std::istreambuf_iterator<char>(file)),
+        std::istreambuf_iterator<char>());
+    return parseLevels(text, options);
+}
+
+bool nextLevelText(std::istream& in, std::string& text) {
+    text.clear();
+    std::string line;
+    std::size_t expected = 0;  // rows still owed to a course header
+    bool inBoard = false;
+    while (std::getline(in, line)) {
+        if (expected > 0) {
+            text += line + '\n';
+            if (--expected == 0) break;
+            continue;
+        }
+        std::string_view body = trimLeft(line);
+        while (!body.empty() && (body.back() == '\r' || body.back() == ' '
+         || body.back() == '\t')) {
+            body.remove_suffix(1);
+        }
+        if (body.empty()) {
+            if (inBoard) break;  // blank line closes an XSB level
+            continue;
+        }
+        if (inBoard && !isXsbRowStart(body[0])) {
+            break;  // title of the next level
+        }
+        text += line + '\n';
+        unsigned int height, width;
+        if (!inBoard && readHeader(body, height, width)) {
+            expected = height;
+            if (expected == 0) break;
+        } else if (isXsbRowStart(body[0])) {
+            inBoard = true;
+        }
+    }
+    // Running into the end of the stream is fine once something was read
+    if (!text.empty()) {
+        in.clear(in.rdstate() & ~std::ios::failbit);
+    }
+    return !text.empty();
+}
+
+std::string formatLevel(const Board& level) {
+    std::string text = std::to_string(level.height()) + " "
+        + std::to_string(level.width()) + "\n";
+    text.reserve(text.size()
+        + static_cast<std::size_t>(level.width() + 1) * level.height());
+    for (unsigned int y = 0; y < level.height(); ++y) {
+        for (unsigned int x = 0; x < level.width(); ++x) {
+            std::size_t i = level.index(x, y);
+            text += level.hasBox(i) && level.isGoal(i) ? '1'
+                : level.tile(x, y);
+        }
+        text += '\n';
+    }
+    return text;
+}
+
+}  // namespace SB
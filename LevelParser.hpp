@@ -0,0 +1,61 @@
+//  Copyright 2025 <Orbosa Igbinovia> [legal/copyright]
+#pragma once
+#include <cstddef>
+#include <istream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Board.hpp"
+
+namespace SB {
+
+//  Where and why a level was rejected. Lines and columns start at 1.
+struct ParseError {
+    std::size_t line = 0;
+    std::size_t column = 0;
+    std::string message;
+};
+
+struct ParseOptions {
+    //  The game accepts spare boxes or spare goals (see isWon), ingestion
+    //  of submitted levels can insist on an exact match
+    bool requireMatchingCounts = false;
+};
+
+struct ParseResult {
+    std::vector<Board> levels;  //  every level before the first error
+    std::optional<ParseError> error;
+    bool ok() const { return !error.has_value(); }
+};
+
+//  Thrown where a ParseResult cannot be handed back, e.g. constructors
+class LevelError : public std::runtime_error {
+ public:
+    explicit LevelError(const ParseError& error);
+    std::size_t line() const;
+    std::size_t column() const;
+
+ private:
+    ParseError detail;
+};
+
+//  Parses every level in the text. Two notations are understood:
+//   - the course format, an "height width" line followed by rows of
+//     '#' wall, '.' floor, 'a' goal, 'A' box, '1' box on goal, '@' player
+//   - XSB, rows of '#' wall, ' ' '-' '_' floor, '.' goal, '$' box,
+//     '*' box on goal, '@' player, '+' player on goal, with levels split
+//     by blank lines and ';' comments or title lines in between
+ParseResult parseLevels(std::string_view text,
+    const ParseOptions& options = ParseOptions());
+//  Reads the whole file in one go and parses it
+ParseResult readLevels(const std::string& filename,
+    const ParseOptions& options = ParseOptions());
+//  Pulls the lines of the next level off a stream, for operator>>
+bool nextLevelText(std::istream& in, std::string& text);
+//  The level in the course format, header line included. The format has
+//  no player-on-goal glyph, so a goal under the player is written as '@'.
+std::string formatLevel(const Board& level);
+
+}  // namespace SB
@@ -0,0 +1,162 @@
+//  Copyright 2025 <Orbosa Igbinovia> [legal/copyright]
+#include "PathPlanner.hpp"
+#include <algorithm>
+
+namespace SB {
+
+namespace {
+constexpr std::size_t kNone = static_cast<std::size_t>(-1);
+constexpr Direction kDirections[4] = {Direction::Up, Direction::Down,
+    Direction::Left, Direction::Right};
+}  // namespace
+
+void PathPlanner::prepare(const Board& board) {
+    if (mark.size() != board.size()) {
+        mark.assign(board.size(), 0);
+        parent.assign(board.size(), 0);
+        seenPush.assign(board.size() * 4, 0);
+        stamp = 0;
+        pushStamp = 0;
+    }
+    if (++stamp == 0) {  // wrapped, start the marks over
+        std::fill(mark.begin(), mark.end(), 0);
+        stamp = 1;
+    }
+}
+
+void PathPlanner::fill(const Board& board, std::size_t from,
+ std::size_t ignore, std::size_t blocker, std::size_t target) {
+    prepare(board);
+    queue.assign(1, static_cast<uint32_t>(from));
+    mark[from] = stamp;
+    for (std::size_t head = 0; head < queue.size(); ++head) {
+        std::size_t sq = queue[head];
+        if (sq == target) {
+            return;  // the rest of the region is not needed
+        }
+        for (Direction dir : kDirections) {
+            std::size_t next = sq + board.step(dir);
+            bool open = next != blocker && (next == ignore
+                || board.isFree(next) || board.piece(next) == Board::Player);
+            if (mark[next] != stamp && open) {
+                mark[next] = stamp;
+                parent[next] = static_cast<uint32_t>(sq);
+                queue.push_back(static_cast<uint32_t>(next));
+            }
+        }
+    }
+}
+
+const std::vector<uint32_t>& PathPlanner::region(const GameState& game) {
+    if (!game.isLoaded()) {
+        queue.clear();
+        return queue;
+    }
+    fill(game.board(), game.player(), kNone, kNone, kNone);
+    return queue;
+}
+
+bool PathPlanner::canReach(const GameState& game, std::size_t square) {
+    if (!game.isLoaded() || square >= game.board().size()) {
+        return false;
+    }
+    fill(game.board(), game.player(), kNone, kNone, square);
+    return mark[square] == stamp;
+}
+
+bool PathPlanner::walkTo(const GameState& game, std::size_t target,
+ std::vector<Direction>& path) {
+    path.clear();
+    if (!canReach(game, target)) {
+        return false;
+    }
+    const Board& board = game.board();
+    for (std::size_t sq = target; sq != game.player(); sq = parent[sq]) {
+        std::ptrdiff_t delta = static_cast<std::ptrdiff_t>(sq)
+            - static_cast<std::ptrdiff_t>(parent[sq]);
+        for (Direction dir : kDirections) {
+            if (board.step(dir) == delta) path.push_back(dir);
+        }
+    }
+    std::reverse(path.begin(), path.end());
+    return true;
+}
+
+bool PathPlanner::pushTo(const GameState& game, std::size_t box,
+ std::size_t target, std::vector<Direction>& path, std::size_t maxStates) {
+    path.clear();
+    const Board& board = game.board();
+    if (!game.isLoaded() || box >= board.size() || target >= board.size()
+     || !board.hasBox(box) || board.isWall(target)) {
+        return false;
+    }
+    if (box == target) {
+        return true;
+    }
+    prepare(board);
+    if (++pushStamp == 0) {
+        std::fill(seenPush.begin(), seenPush.end(), 0);
+        pushStamp = 1;
+    }
+
+    // Breadth first over box squares. The player always stands behind the
+    // box after a push, so (box square, last direction) is the state.
+    pushes.clear();
+    pushes.push_back({static_cast<uint32_t>(box), 0, Direction::Up});
+    std::size_t found = kNone;
+    for (std::size_t head = 0; head < pushes.size() && found == kNone;
+     ++head) {
+        std::size_t at = pushes[head].box;
+        std::size_t player = head == 0 ? game.player()
+            : at - board.step(pushes[head].dir);
+        // The moving box is at "at" now, its start square is empty
+        fill(board, player, box, at, kNone);
+        for (Direction dir : kDirections) {
+            std::size_t behind = at - board.step(dir);
+            std::size_t to = at + board.step(dir);
+            bool toOpen = to == box || board.isFree(to)
+                || board.piece(to) == Board::Player;
+            if (mark[behind] != stamp || !toOpen) {
+                continue;
+            }
+            std::size_t key = to * 4 + static_cast<std::size_t>(dir);
+            if (seenPush[key] == pushStamp) {
+                continue;
+            }
+            seenPush[key] = pushStamp;
+            pushes.push_back({static_cast<uint32_t>(to),
+                static_cast<uint32_t>(head), dir});
+            if (to == target) {
+                found = pushes.size() - 1;
+                break;
+            }
+            if (pushes.size() >= maxStates) {
+                return false;
+            }
+        }
+    }
+    if (found == kNone) {
+        return false;
+    }
+
+    // Replay the pushes on a copy, walking behind the box before each
+    std::vector<Direction> order;
+    for (std::size_t n = found; n != 0; n = pushes[n].parent) {
+        order.push_back(pushes[n].dir);
+    }
+    std::reverse(order.begin(), order.end());
+    GameState scratch = game;
+    std::size_t at = box;
+    std::vector<Direction> walk;
+    for (Direction dir : order) {
+        walkTo(scratch, at - board.step(dir), walk);
+        for (Direction step : walk) scratch.move(step);
+        scratch.move(dir);
+        path.insert(path.end(), walk.begin(), walk.end());
+        path.push_back(dir);
+        at += board.step(dir);
+    }
+    return true;
+}
+
+}  // namespace SB
@@ -0,0 +1,54 @@
+//  Copyright 2025 <Orbosa Igbinovia> [legal/copyright]
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "GameState.hpp"
+
+namespace SB {
+
+//  Where the player can go and how to get there. Every query is one
+//  breadth-first search over the board, bounded by its size, and the
+//  buffers are kept between queries so repeated calls do not allocate.
+class PathPlanner {
+ public:
+    //  Squares the player can walk to without pushing anything
+    const std::vector<uint32_t>& region(const GameState& game);
+    bool canReach(const GameState& game, std::size_t square);
+
+    //  Shortest walk to target that never pushes a box. False, with path
+    //  left empty, when target cannot be reached.
+    bool walkTo(const GameState& game, std::size_t target,
+        std::vector<Direction>& path);
+
+    //  Moves that push the box on square box onto target, fewest pushes
+    //  first, leaving every other box where it is. At most maxStates
+    //  box positions are searched. False when there is no such path.
+    bool pushTo(const GameState& game, std::size_t box, std::size_t target,
+        std::vector<Direction>& path, std::size_t maxStates = 1 << 16);
+
+ private:
+    //  One box position in the push search, with the direction of the
+    //  push that produced it
+    struct PushState {
+        uint32_t box;
+        uint32_t parent;
+        Direction dir;
+    };
+
+    std::vector<uint32_t> mark;  //  == stamp when visited in this search
+    std::vector<uint32_t> parent;
+    std::vector<uint32_t> queue;
+    std::vector<uint32_t> seenPush;  //  box square * 4 + direction
+    std::vector<PushState> pushes;
+    uint32_t stamp = 0;
+    uint32_t pushStamp = 0;
+
+    //  Flood fill from the player. ignore is a box square to treat as
+    //  empty and blocker a square to treat as a box (both optional).
+    void fill(const Board& board, std::size_t from, std::size_t ignore,
+        std::size_t blocker, std::size_t target);
+    void prepare(const Board& board);
+};
+
+}  // namespace SB
@@ -0,0 +1,136 @@
+//  Copyright 2025 <Orbosa Igbinovia> [legal/copyright]
+#include "Profiler.hpp"
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+namespace SB {
+
+uint64_t ProbeStats::percentileNs(double fraction) const {
+    uint64_t wanted = static_cast<uint64_t>(fraction * calls);
+    uint64_t seen = 0;
+    for (std::size_t i = 0; i < Buckets; ++i) {
+        seen += histogram[i];
+        if (seen > wanted) {
+            return uint64_t{1} << i;
+        }
+    }
+    return 0;
+}
+
+Profiler& Profiler::instance() {
+    static Profiler profiler;
+    return profiler;
+}
+
+std::size_t Profiler::probe(const char* name) {
+    std::lock_guard<std::mutex> guard(lock);
+    std::size_t n = used.load(std::memory_order_relaxed);
+    for (std::size_t i = 0; i < n; ++i) {
+        if (std::strcmp(probes[i].name, name) == 0) {
+            return i;
+        }
+    }
+    if (n == MaxProbes) {
+        return MaxProbes - 1;  // full, later probes share the last slot
+    }
+    probes[n].name = name;
+    used.store(n + 1, std::memory_order_release);
+    return n;
+}
+
+void Profiler::record(std::size_t index, uint64_t ns) {
+    Probe& p = probes[index];
+    p.calls.fetch_add(1, std::memory_order_relaxed);
+    p.totalNs.fetch_add(ns, std::memory_order_relaxed);
+    uint64_t seen = p.maxNs.load(std::memory_order_relaxed);
+    while (ns > seen && !p.maxNs.compare_exchange_weak(seen, ns,
+        std::memory_order_relaxed)) {
+    }
+    std::size_t bucket = 0;
+    while (bucket + 1 < ProbeStats::Buckets && (ns >> bucket) != 0) {
+        ++bucket;
+    }
+    p.histogram[bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+void Profiler::count(std::size_t index, uint64_t events) {
+    probes[index].calls.fetch_add(events, std::memory_order_relaxed);
+}
+
+std::vector<ProbeStats> Profiler::snapshot() const {
+    std::lock_guard<std::mutex> guard(lock);
+    std::vector<ProbeStats> stats(used.load(std::memory_order_acquire));
+    for (std::size_t i = 0; i < stats.size(); ++i) {
+        const Probe& p = probes[i];
+        stats[i].name = p.name;
+        stats[i].calls = p.calls.load(std::memory_order_relaxed);
+        stats[i].totalNs = p.totalNs.load(std::memory_order_relaxed);
+        stats[i].maxNs = p.maxNs.load(std::memory_order_relaxed);
+        for (std::size_t b = 0; b < ProbeStats::Buckets; ++b) {
+            stats[i].histogram[b] =
+                p.histogram[b].load(std::memory_order_relaxed);
+        }
+    }
+    return stats;
+}
+
+std::string Profiler::summary() const {
+    std::ostringstream out;
+    for (const ProbeStats& s : snapshot()) {
+        out << s.name << ": " << s.calls;
+        if (s.timed()) {
+            out << " x, p50 " << s.percentileNs(0.5) / 1000.0
+                << "us, p99 " << s.percentileNs(0.99) / 1000.0
+                << "us, max " << s.maxNs / 1000.0 << "us";
+        }
+        out << "\n";
+    }
+    return out.str();
+}
+
+void Profiler::writeJson(std::ostream& out) const {
+    std::vector<ProbeStats> stats = snapshot();
+    out << "{\n  \"probes\": [";
+    for (std::size_t i = 0; i < stats.size(); ++i) {
+        const ProbeStats& s = stats[i];
+        out << (i == 0 ? "\n" : ",\n") << "    {\"name\": \"" << s.name
+            << "\", \"calls\": " << s.calls;
+        if (s.timed()) {
+            out << ", \"totalNs\": " << s.totalNs
+                << ", \"maxNs\": " << s.maxNs
+                << ", \"p50Ns\": " << s.percentileNs(0.5)
+                << ", \"p99Ns\": " << s.percentileNs(0.99)
+                << ", \"histogram\": [";
+            // Trailing empty buckets are left off
+            std::size_t last = ProbeStats::Buckets;
+            while (last > 0 && s.histogram[last - 1] == 0) --last;
+            for (std::size_t b = 0; b < last; ++b) {
+                out << (b == 0 ? "" : ", ") << s.histogram[b];
+            }
+            out << "]";
+        }
+        out << "}";
+    }
+    out << "\n  ]\n}\n";
+}
+
+bool Profiler::dump(const std::string& filename) const {
+    std::ofstream out(filename);
+    writeJson(out);
+    return static_cast<bool>(out);
+}
+
+void Profiler::clear() {
+    std::lock_guard<std::mutex> guard(lock);
+    for (Probe& p : probes) {
+        p.calls.store(0, std::memory_order_relaxed);
+        p.totalNs.store(0, std::memory_order_relaxed);
+        p.maxNs.store(0, std::memory_order_relaxed);
+        for (auto& bucket : p.histogram) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+}  // namespace SB
@@ -0,0 +1,110 @@
+//  Copyright 2025 <Orbosa Igbinovia> [legal/copyright]
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+//  Hot path instrumentation. SB_PROFILE_SCOPE("name") times the rest of
+//  the enclosing block and SB_PROFILE_COUNT("name") counts one event.
+//  Both expand to nothing unless the build defines SOKOBAN_PROFILE
+//  (make PROFILE=1), so a normal build pays nothing for them.
+#ifdef SOKOBAN_PROFILE
+#define SB_PROFILE_JOIN2(a, b) a##b
+#define SB_PROFILE_JOIN(a, b) SB_PROFILE_JOIN2(a, b)
+#define SB_PROFILE_SCOPE(name) \
+    static const std::size_t SB_PROFILE_JOIN(sbProbe, __LINE__) = \
+        ::SB::Profiler::instance().probe(name); \
+    ::SB::ScopedTimer SB_PROFILE_JOIN(sbTimer, __LINE__)( \
+        SB_PROFILE_JOIN(sbProbe, __LINE__))
+#define SB_PROFILE_COUNT(name) \
+    do { \
+        static const std::size_t sbProbe = \
+            ::SB::Profiler::instance().probe(name); \
+        ::SB::Profiler::instance().count(sbProbe); \
+    } while (0)
+#else
+#define SB_PROFILE_SCOPE(name) static_cast<void>(0)
+#define SB_PROFILE_COUNT(name) static_cast<void>(0)
+#endif
+
+namespace SB {
+
+//  Everything one probe has seen. Times go into power of two buckets of
+//  nanoseconds, so percentiles are accurate to within a factor of two.
+struct ProbeStats {
+    static constexpr std::size_t Buckets = 48;
+    std::string name;
+    uint64_t calls = 0;
+    uint64_t totalNs = 0;
+    uint64_t maxNs = 0;
+    //  [i] counts calls under 2^i ns that did not fit in [i - 1]
+    std::array<uint64_t, Buckets> histogram{};
+    bool timed() const { return totalNs > 0 || maxNs > 0; }
+    //  Upper bound of the bucket holding the given fraction of calls
+    uint64_t percentileNs(double fraction) const;
+};
+
+//  Process-wide probe table. Probes register by name once (the macros keep
+//  the index in a function static) and then record with relaxed atomics,
+//  so the solver threads can share it.
+class Profiler {
+ public:
+    static constexpr std::size_t MaxProbes = 64;
+
+    static Profiler& instance();
+    //  Index of the probe with this name, added on first use. Names must
+    //  outlive the process (string literals).
+    std::size_t probe(const char* name);
+    void record(std::size_t probe, uint64_t ns);
+    void count(std::size_t probe, uint64_t events = 1);
+
+    std::vector<ProbeStats> snapshot() const;
+    //  One short line per probe, for the in-game overlay
+    std::string summary() const;
+    void writeJson(std::ostream& out) const;
+    //  writeJson into a file, false if it cannot be written
+    bool dump(const std::string& filename) const;
+    void clear();
+
+ private:
+    struct Probe {
+        const char* name = nullptr;
+        std::atomic<uint64_t> calls{0};
+        std::atomic<uint64_t> totalNs{0};
+        std::atomic<uint64_t> maxNs{0};
+        std::array<std::atomic<uint64_t>, ProbeStats::Buckets> histogram{};
+    };
+
+    Profiler() = default;
+
+    mutable std::mutex lock;  //  only taken to add a probe or read them
+    std::array<Probe, MaxProbes> probes;
+    std::atomic<std::size_t> used{0};
+};
+
+//  Records the time from construction to destruction against a probe
+class ScopedTimer {
+ public:
+    explicit ScopedTimer(std::size_t probe)
+        : index(probe), start(std::chrono::steady_clock::now()) {}
+    ~ScopedTimer() {
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        Profiler::instance().record(index, static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+                .count()));
+    }
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+ private:
+    std::size_t index;
+    std::chrono::steady_clock::time_point start;
+};
+
+}  // namespace SB
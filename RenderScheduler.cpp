@@ -0,0 +1,44 @@
+//  Copyright 2025 <Orbosa Igbinovia> [legal/copyright]
+#include "RenderScheduler.hpp"
+#include <algorithm>
+#include "Profiler.hpp"
+
+namespace SB {
+
+RenderScheduler::RenderScheduler(sf::Time maxNap) : maxNap(maxNap) {}
+
+bool RenderScheduler::waitEvent(sf::Window& window, sf::Event& event,
+ sf::Time timeout) {
+    sf::Clock waited;
+    while (!window.pollEvent(event)) {
+        sf::Time left = timeout - waited.getElapsedTime();
+        if (left <= sf::Time::Zero) {
+            return false;
+        }
+        ++woken;
+        if (!window.hasFocus()) {
+            // no key presses to catch, but closing and resizing still count
+            sf::sleep(std::min(left, maxNap));
+            continue;
+        }
+        sf::sleep(std::min(left, nap));
+        nap = std::min(nap * 2.f, maxNap);
+    }
+    nap = sf::milliseconds(1);  // more input tends to follow
+    return true;
+}
+
+bool RenderScheduler::present(sf::RenderWindow& window, const Sokoban& game) {
+    if (!game.needsRedraw()) {
+        ++skipped;
+        return false;
+    }
+    SB_PROFILE_SCOPE("frame");
+    window.clear();
+    window.draw(game);
+    window.display();
+    ++drawn;
+    return true;
+}
+
+}  // namespace SB
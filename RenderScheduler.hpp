@@ -0,0 +1,42 @@
+//  Copyright 2025 <Orbosa Igbinovia> [legal/copyright]
+#pragma once
+#include <cstddef>
+#include <SFML/Graphics.hpp>
+#include "Sokoban.hpp"
+
+namespace SB {
+
+//  Decides when the window loop draws and how long it sleeps. The loop
+//  waits for input with a timeout instead of spinning, and a frame is only
+//  drawn when the game says something on screen changed.
+//
+//  SFML 2 cannot wait on events with a timeout, so the wait polls, but
+//  the naps between polls back off: 1 ms right after an event, doubling
+//  up to maxNap while the focused window stays quiet. A window without
+//  focus gets no key presses and naps maxNap at a time from the start, so
+//  closing, resizing or focusing it is still seen within one nap.
+class RenderScheduler {
+ public:
+    //  Longest nap, and so the worst delay before input that follows a
+    //  quiet spell is noticed
+    explicit RenderScheduler(sf::Time maxNap = sf::milliseconds(16));
+
+    //  Next event, or false once timeout passes without one
+    bool waitEvent(sf::Window& window, sf::Event& event, sf::Time timeout);
+    //  Draws and displays a frame if the game needs one. True if it did.
+    bool present(sf::RenderWindow& window, const Sokoban& game);
+
+    std::size_t framesDrawn() const { return drawn; }
+    std::size_t framesSkipped() const { return skipped; }
+    //  Polls that found nothing
+    std::size_t wakeups() const { return woken; }
+
+ private:
+    sf::Time maxNap;
+    sf::Time nap = sf::milliseconds(1);
+    std::size_t woken = 0;
+    std::size_t drawn = 0;
+    std::size_t skipped = 0;
+};
+
+}  // namespace SB
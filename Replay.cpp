@@ -0,0 +1,118 @@
+//  Copyright 2025 <Orbosa Igbinovia> [legal/copyright]
+#include "Replay.hpp"
+#include <algorithm>
+
+namespace SB {
+
+namespace {
+bool readLetter(char c, Direction& dir, bool& push) {
+    push = c >= 'A' && c <= 'Z';
+    switch (push ? static_cast<char>(c - 'A' + 'a') : c) {
+        case 'l': dir = Direction::Left; return true;
+        case 'u': dir = Direction::Up; return true;
+        case 'r': dir = Direction::Right; return true;
+        case 'd': dir = Direction::Down; return true;
+        default: return false;
+    }
+}
+
+char letter(Direction dir, bool push) {
+    char c = 'u';
+    switch (dir) {
+        case Direction::Up:    c = 'u'; break;
+        case Direction::Down:  c = 'd'; break;
+        case Direction::Left:  c = 'l'; break;
+        case Direction::Right: c = 'r'; break;
+    }
+    return push ? static_cast<char>(c - 'a' + 'A') : c;
+}
+}  // namespace
+
+Replay::Replay(const GameState& start, std::size_t interval)
+    : game(start), interval(std::max<std::size_t>(interval, 1)) {
+    checkpoints.push_back(game.position());
+}
+
+bool Replay::play(std::string_view lurd) {
+    if (failure) {
+        return false;
+    }
+    seek(steps.size());
+    steps.reserve(steps.size() + lurd.size());
+    game.reserveHistory(game.historyPosition() + lurd.size());
+
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < lurd.size(); ++i) {
+        char c = lurd[i];
+        if (c == ' ' || c == '\t' || c == '\n' || c == '\r') {
+            continue;
+        }
+        if (c >= '0' && c <= '9') {
+            count = count * 10 + static_cast<std::size_t>(c - '0');
+            continue;
+        }
+        Direction dir;
+        bool push;
+        if (!readLetter(c, dir, push)) {
+            failure = ReplayError{steps.size(), i,
+                std::string("unexpected character '") + c + "'"};
+            return false;
+        }
+        for (std::size_t n = std::max<std::size_t>(count, 1); n > 0; --n) {
+            std::size_t next = game.player() + game.board().step(dir);
+            if (game.board().hasBox(next) != push) {
+                failure = ReplayError{steps.size(), i, push
+                    ? "push letter but there is no box to push"
+                    : "step letter but it would push a box"};
+                return false;
+            }
+            if (!game.move(dir)) {
+                failure = ReplayError{steps.size(), i, "move is blocked"};
+                return false;
+            }
+            steps.push_back(dir);
+            if (++at % interval == 0) {
+                checkpoints.push_back(game.position());
+            }
+        }
+        count = 0;
+    }
+    if (count != 0) {
+        failure = ReplayError{steps.size(), lurd.size(),
+            "count with no move after it"};
+        return false;
+    }
+    return true;
+}
+
+void Replay::seek(std::size_t move) {
+    move = std::min(move, steps.size());
+    if (move == at) {
+        return;
+    }
+    // Walk forward from where we are if that is closer than a checkpoint
+    std::size_t checkpoint = move / interval;
+    if (move < at || move - at > move - checkpoint * interval) {
+        game.setPosition(checkpoints[checkpoint]);
+        at = checkpoint * interval;
+    }
+    for (; at < move; ++at) {
+        game.move(steps[at]);
+    }
+}
+
+bool Replay::solves() const {
+    return !failure && at == steps.size() && game.isWon();
+}
+
+std::string toLurd(const GameState& game) {
+    std::string lurd;
+    lurd.reserve(game.historyPosition());
+    for (std::size_t i = 0; i < game.historyPosition(); ++i) {
+        const moveRecord& move = game.history()[i];
+        lurd.push_back(letter(move.dir, move.box >= 0));
+    }
+    return lurd;
+}
+
+}  // namespace SB
@@ -0,0 +1,58 @@
+//  Copyright 2025 <Orbosa Igbinovia> [legal/copyright]
+#pragma once
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "GameState.hpp"
+
+namespace SB {
+
+//  Where a move string stopped making sense. move counts from 0.
+struct ReplayError {
+    std::size_t move = 0;
+    std::size_t offset = 0;  //  character in the string
+    std::string message;
+};
+
+//  Plays LURD strings: l u r d for a step, L U R D for a step that pushes
+//  a box. A count may come before a letter ("3r" is "rrr"), whitespace is
+//  skipped. Moves run straight on a GameState with the journal reserved up
+//  front, so nothing is drawn or allocated per move. A checkpoint of the
+//  position is kept every interval moves, so seek() replays at most
+//  interval moves from the nearest one.
+class Replay {
+ public:
+    static constexpr std::size_t DEFAULT_INTERVAL = 256;
+
+    explicit Replay(const GameState& start,
+        std::size_t interval = DEFAULT_INTERVAL);
+
+    //  Appends and applies the moves. Stops at the first blocked move,
+    //  wrong push letter or unknown character and returns false.
+    bool play(std::string_view lurd);
+    //  Moves accepted so far
+    std::size_t size() const { return steps.size(); }
+    //  Moves applied to state() at the moment
+    std::size_t position() const { return at; }
+    //  Puts state() after the given number of moves (clamped to size())
+    void seek(std::size_t move);
+    const GameState& state() const { return game; }
+    const std::optional<ReplayError>& error() const { return failure; }
+    //  Every move played and the level won at the end
+    bool solves() const;
+
+ private:
+    GameState game;
+    std::vector<Direction> steps;
+    std::vector<Position> checkpoints;  //  [k] is after k * interval moves
+    std::size_t interval;
+    std::size_t at = 0;
+    std::optional<ReplayError> failure;
+};
+
+//  Journal of a game up to its current position as LURD
+std::string toLurd(const GameState& game);
+
+}  // namespace SB
@@ -0,0 +1,95 @@
+//  Copyright 2025 <Orbosa Igbinovia> [legal/copyright]
+#include "Session.hpp"
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+#include "LevelParser.hpp"
+
+namespace SB {
+
+namespace {
+constexpr std::size_t kNone = static_cast<std::size_t>(-1);
+}  // namespace
+
+Session::Session(const std::vector<std::string>& files)
+    : inputs(files), prefetched(kNone) {
+    for (std::size_t i = 0; i < inputs.size(); ++i) {
+        if (LevelPack::isPack(inputs[i])) {
+            packs.push_back(std::make_unique<const LevelPack>(inputs[i]));
+            for (std::size_t level = 0; level < packs.back()->size();
+             ++level) {
+                levels.push_back({i, level, 0});
+            }
+            continue;
+        }
+        std::ifstream file(inputs[i], std::ios::binary);
+        if (!file) {
+            throw std::runtime_error("Unable to open file: " + inputs[i]);
+        }
+        // Only the level breaks are found here, parsing waits
+        std::string text;
+        std::streamoff at = file.tellg();
+        for (std::size_t level = 0; nextLevelText(file, text); ++level) {
+            levels.push_back({i, level, at});
+            at = file.tellg();
+        }
+        packs.push_back(nullptr);
+    }
+}
+
+Session::~Session() {
+    if (pending.valid()) {
+        pending.wait();  // the task reads this session
+    }
+}
+
+const std::string& Session::source(std::size_t index) const {
+    return inputs.at(levels.at(index).input);
+}
+
+GameState Session::prepare(std::size_t index) const {
+    const LevelRef& ref = levels[index];
+    if (packs[ref.input]) {
+        return GameState(packs[ref.input]->level(ref.index));
+    }
+    std::ifstream file(inputs[ref.input], std::ios::binary);
+    file.seekg(ref.offset);
+    std::string text;
+    if (!file || !nextLevelText(file, text)) {
+        throw std::runtime_error(inputs[ref.input] + " changed on disk");
+    }
+    ParseResult parsed = parseLevels(text);
+    if (!parsed.ok()) {
+        ParseError error = *parsed.error;
+        error.message = inputs[ref.input] + " level "
+            + std::to_string(ref.index + 1) + ": " + error.message;
+        throw LevelError(error);
+    }
+    return GameState(parsed.levels.front());
+}
+
+GameState Session::load(std::size_t index) {
+    if (index >= levels.size()) {
+        throw std::out_of_range("no level " + std::to_string(index));
+    }
+    GameState level;
+    if (pending.valid() && prefetched == index) {
+        level = pending.get();
+    } else {
+        if (pending.valid()) {
+            pending.wait();  // a jump elsewhere, that work is thrown away
+        }
+        level = prepare(index);
+    }
+    pos = index;
+    prefetched = kNone;
+    pending = std::future<GameState>();
+    if (index + 1 < levels.size()) {
+        prefetched = index + 1;
+        pending = std::async(std::launch::async,
+            [this, index] { return prepare(index + 1); });
+    }
+    return level;
+}
+
+}  // namespace SB
@@ -0,0 +1,60 @@
+//  Copyright 2025 <Orbosa Igbinovia> [legal/copyright]
+#pragma once
+#include <cstddef>
+#include <future>
+#include <ios>
+#include <memory>
+#include <string>
+#include <vector>
+#include "GameState.hpp"
+#include "LevelPack.hpp"
+
+namespace SB {
+
+//  A playlist of levels from .lvl files and level packs, played in order.
+//  While one level is being played the next one is parsed and analysed
+//  (dead squares and all) on a background thread, so moving on after a
+//  win only has to hand over a finished GameState.
+class Session {
+ public:
+    //  Every level of every input, in order. Packs are mapped and .lvl
+    //  files only scanned for where each level starts, so loading one
+    //  seeks straight to it; nothing is parsed yet.
+    explicit Session(const std::vector<std::string>& inputs);
+    ~Session();
+    Session(const Session&) = delete;
+    Session& operator=(const Session&) = delete;
+
+    std::size_t size() const { return levels.size(); }
+    //  Index of the level handed out last
+    std::size_t position() const { return pos; }
+    bool hasNext() const { return pos + 1 < levels.size(); }
+    //  File the level came from, for window titles and messages
+    const std::string& source(std::size_t index) const;
+
+    //  The level at index, ready to play. Comes straight from the
+    //  prefetch when it is the one being prepared, otherwise it is loaded
+    //  now. Either way the level after it starts preparing. Throws
+    //  std::out_of_range for a bad index and LevelError for a bad level.
+    GameState load(std::size_t index);
+    GameState next() { return load(pos + 1); }
+
+ private:
+    struct LevelRef {
+        std::size_t input;  //  into inputs
+        std::size_t index;  //  level within that file
+        std::streamoff offset;  //  where a .lvl level's text starts
+    };
+
+    std::vector<std::string> inputs;
+    std::vector<std::unique_ptr<const LevelPack>> packs;  //  null for .lvl
+    std::vector<LevelRef> levels;
+    std::size_t pos = 0;
+    std::size_t prefetched;  //  level pending will produce
+    std::future<GameState> pending;
+
+    //  Parses and analyses one level; safe to run off the main thread
+    GameState prepare(std::size_t index) const;
+};
+
+}  // namespace SB
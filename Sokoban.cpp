@@ -1,92 +1,95 @@
 
 //  Copyright 2025 <Orbosa Igbinovia> [legal/copyright]
 #include "Sokoban.hpp"
-#include <fstream>
+#include <algorithm>
 #include <stdexcept>
+#include <utility>
+#include "AssetCache.hpp"
+#include "LevelParser.hpp"
+#include "Profiler.hpp"
 
 namespace SB {
 
-// load textures from file and into the sprite.
+// load a texture from file into the renderer's atlas slot for the tile.
 void Sokoban::loadTexture(char tile, const std::string& filename) {
-    if (!textures[tile].loadFromFile(filename)) {
+    SB_PROFILE_SCOPE("texture_load");
+    BoardRenderer::Slot slot;
+    switch (tile) {
+        case '#': slot = BoardRenderer::WallTile; break;
+        case '.': slot = BoardRenderer::FloorTile; break;
+        case 'a': slot = BoardRenderer::GoalTile; break;
+        case 'A': slot = BoardRenderer::BoxTile; break;
+        case '@': slot = BoardRenderer::PlayerDown; break;
+        default:
+            std::cerr << "No atlas slot for tile: " << tile << std::endl;
+            return;
+    }
+    if (!renderer.loadTile(slot, filename)) {
         std::cerr << "Failed to load texture for tile '" << tile
                   << "' from file: " << filename << std::endl;
-    } else {
-        sprites[tile].setTexture(textures[tile]);
     }
 }
 
-// Default constructor
-Sokoban::Sokoban() : o_height(0), o_width(0) {
-    moveCount = 0;
-    if (font.getInfo().family.empty()) {
-        if (!font.loadFromFile
-            ("/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf")) {
-            std::cerr << "Warning: Could not load system font."
-             "Move counter won't be displayed.\n";
-            return;
-        }
-    }
-    // Load textures for each character type
-    loadTexture('#', "block_06.png");
-    loadTexture('.', "ground_01.png");
-    loadTexture('A', "crate_03.png");
-    loadTexture('a', "ground_04.png");
-    loadTexture('@', "player_05.png");
-
-    for (const auto& [tile, texture] : textures) {
-        sprites[tile].setTexture(texture);
+// Fonts come from the shared cache, so only the first Sokoban reads the file
+void Sokoban::setupText() {
+    font = AssetCache::instance().font(
+        "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf");
+    if (font == nullptr) {
+        std::cerr << "Warning: Could not load system font."
+         "Move counter won't be displayed.\n";
+        return;
     }
-}
-
-// Constructor to load the level from a file
-Sokoban::Sokoban(const std::string& filename) {
-    moveCount = 0;
-    levelFilename = filename;
-
-    if (font.getInfo().family.empty()) {
-        if (!font.loadFromFile
-            ("/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf")) {
-            std::cerr << "Warning: Could not load system font."
-             "Move counter won't be displayed.\n";
-            return;
-        }
-    }
-    moveText.setFont(font);
+    moveText.setFont(*font);
     moveText.setCharacterSize(18);
     moveText.setFillColor(sf::Color::Yellow);
     moveText.setPosition(10.f, 10.f);
     moveText.setString("Moves: 0");
 
     winText.setCharacterSize(32);
-    winText.setFont(font);
+    winText.setFont(*font);
     winText.setFillColor(sf::Color::Blue);
     winText.setString("CONGRATS, YOU WIN.");
     winText.setPosition(150.f, 300.f);
 
-    timeText.setFont(font);
+    stuckText.setFont(*font);
+    stuckText.setCharacterSize(24);
+    stuckText.setFillColor(sf::Color::Red);
+    stuckText.setString("Deadlocked - press U to undo");
+    stuckText.setPosition(150.f, 260.f);
+
+    timeText.setFont(*font);
     timeText.setCharacterSize(18);
     timeText.setFillColor(sf::Color::White);
     timeText.setPosition(10.f, 35.f);
     timeText.setString("Time: 0s");
 
-    loadTexture('#', "block_06.png");
-    loadTexture('.', "ground_01.png");
-    loadTexture('A', "crate_03.png");
-    loadTexture('a', "ground_04.png");
-    loadTexture('@', "player_05.png");
+    profileText.setFont(*font);
+    profileText.setCharacterSize(14);
+    profileText.setFillColor(sf::Color::Cyan);
+    profileText.setPosition(10.f, 60.f);
 
-    for (const auto& [tile, texture] : textures) {
-        sprites[tile].setTexture(texture);
-    }
+    selection.setSize(sf::Vector2f(TILE_SIZE - 4.f, TILE_SIZE - 4.f));
+    selection.setFillColor(sf::Color::Transparent);
+    selection.setOutlineColor(sf::Color::Yellow);
+    selection.setOutlineThickness(2.f);
+}
 
-    std::ifstream file(filename);
-    if (file) {
-        file >> *this;
-        originalBoard = board;  // for my reset method
-    } else {
-        throw std::runtime_error("Unable to open file: " + filename);
+// Default constructor
+Sokoban::Sokoban() : o_height(0), o_width(0) {
+    setupText();
+}
+
+// Constructor to load the level from a file
+Sokoban::Sokoban(const std::string& filename) {
+    levelFilename = filename;
+    setupText();
+
+    // Only the first level of a multi-level file is played
+    ParseResult result = readLevels(filename);
+    if (!result.ok()) {
+        throw LevelError(*result.error);
     }
+    loadBoard(result.levels.front());
 }
 
 unsigned int Sokoban::height() const { return o_height; }
@@ -95,186 +98,266 @@ unsigned int Sokoban::getHeight() const { return o_height; }
 unsigned int Sokoban::getWidth() const { return o_width; }
 void Sokoban::setHeight(unsigned int height) { o_height = height; }
 void Sokoban::setWidth(unsigned int width) { o_width = width; }
-sf::Vector2u Sokoban::playerLoc() const { return playerPosition; }
+sf::Vector2u Sokoban::playerLoc() const {
+    const Board& board = game.board();
+    if (!game.isLoaded()) {
+        return {};
+    }
+    return {board.column(game.player()), board.row(game.player())};
+}
 
 char Sokoban::getTile(unsigned int x, unsigned int y) const {
-    if (y < board.size() && x < board[y].size()) {
-        return board[y][x];
+    const Board& board = game.board();
+    if (x < board.width() && y < board.height()) {
+        return board.tile(x, y);
     }
     return '?';  // invalid tile
 }
 
 std::vector<sf::Vector2u> Sokoban::getBoxes() const {
-    return boxPos;
+    const Board& board = game.board();
+    std::vector<sf::Vector2u> boxes;
+    boxes.reserve(game.boxes().size());
+    for (uint32_t i : game.boxes()) {
+        boxes.push_back({board.column(i), board.row(i)});
+    }
+    return boxes;
+}
+
+std::vector<sf::Vector2u> Sokoban::getGoals() const {
+    const Board& board = game.board();
+    std::vector<sf::Vector2u> goals;
+    for (unsigned int y = 0; y < board.height(); ++y) {
+        for (unsigned int x = 0; x < board.width(); ++x) {
+            if (board.isGoal(board.index(x, y))) {
+                goals.push_back({x, y});
+            }
+        }
+    }
+    return goals;
+}
+
+const Board& Sokoban::getBoard() const {
+    return game.board();
+}
+
+const GameState& Sokoban::state() const {
+    return game;
 }
 
 bool Sokoban::isWon() const {
-    // Case 1: Every goal has a box
-    bool allGoalsCovered = std::all_of(goalPosition.begin(), goalPosition.end(),
-        [this](const sf::Vector2u& goal) {
-            return std::find(boxPos.begin(),
-             boxPos.end(), goal) != boxPos.end();
-        });
-
-    // Case 2: Every box is on a goal
-    bool allBoxesPlaced = std::all_of(boxPos.begin(), boxPos.end(),
-        [this](const sf::Vector2u& box) {
-            return std::find(goalPosition.begin(),
-             goalPosition.end(), box) != goalPosition.end();
-        });
-
-    if (allGoalsCovered || allBoxesPlaced) {
+    SB_PROFILE_SCOPE("win_check");
+    if (game.isLoaded() && game.isWon()) {
         totalElapsedTime = gameClock.getElapsedTime();
-        std::cout << "Congrats, You've won!!" << std::endl;
         return true;
     }
 
     return false;
 }
 
+bool Sokoban::isDeadlocked() const {
+    return game.isLoaded() && game.isDeadlocked();
+}
 
+void Sokoban::showMove(const moveRecord& move) {
+    const Board& board = game.board();
+    if (move.box >= 0) {
+        uint32_t i = game.boxes()[move.box];
+        renderer.placeBox(move.box, {board.column(i), board.row(i)});
+    }
+    renderer.placePlayer(playerLoc());
+}
+
+void Sokoban::updateStatus() {
+    moveText.setString("Moves: " + std::to_string(game.moves()));
+    dirty = true;
+}
+
+sf::Time Sokoban::playTime() const {
+    return hasWon ? totalElapsedTime : gameClock.getElapsedTime();
+}
+
+int Sokoban::elapsedSeconds() const {
+    return static_cast<int>(playTime().asSeconds());
+}
+
+bool Sokoban::needsRedraw() const {
+    return dirty || elapsedSeconds() != shownSecond;
+}
+
+sf::Time Sokoban::untilRedraw() const {
+    if (needsRedraw()) {
+        return sf::Time::Zero;
+    }
+    if (hasWon) {
+        return sf::seconds(1.f);  // the timer is stopped, only input counts
+    }
+    sf::Int64 us = gameClock.getElapsedTime().asMicroseconds();
+    return sf::microseconds(1000000 - us % 1000000);
+}
+
+void Sokoban::showLatency(const std::string& line) {
+    if (line != latencyLine) {
+        latencyLine = line;
+        dirty |= showProfile;
+    }
+}
 
 void Sokoban::movePlayer(Direction dir) {
-    int dx = 0, dy = 0;
-    switch (dir) {
-        case Direction::Up:    dy = -1;
-        loadTexture('@', "player_08.png"); break;
-        case Direction::Down:  dy = 1;
-        loadTexture('@', "player_05.png"); break;
-        case Direction::Left:  dx = -1;
-        loadTexture('@', "player_20.png"); break;
-        case Direction::Right: dx = 1;
-        loadTexture('@', "player_17.png"); break;
-    }
-
-    undoStack.push(gameState{board, playerPosition, boxPos, moveCount});
-
-    unsigned int px = playerPosition.x, py = playerPosition.y;
-    unsigned int nx = px + dx, ny = py + dy;
-
-    if (nx >= 0 && nx < o_width
-     && ny >= 0 && ny < o_height) {
-        char nextTile = board[ny][nx];
-
-        if (nextTile == '.' || nextTile == 'a') {
-            if (std::find(goalPosition.begin(), goalPosition.end(),
-             sf::Vector2u{px, py}) != goalPosition.end()) {
-                // Restore goal under player if player was on it
-                board[py][px] = 'a';
-            } else {
-                board[py][px] = '.';  // Otherwise, just clear the tile
-            }
-            board[ny][nx] = '@';  // Move player to the new tile
-            playerPosition =
-             {static_cast<unsigned>(nx), static_cast<unsigned>(ny)};
-            moveCount++;
-        } else if (nextTile == 'A') {
-            int bx = nx + dx, by = ny + dy;
-            if (bx >= 0 && bx < static_cast<int>(o_width)
-             && by >= 0 && by < static_cast<int>(o_height)) {
-                char beyondBox = board[by][bx];
-                if (beyondBox == '.' || beyondBox == 'a') {
-                    // Move box onto storage or floor
-                    if (std::find(goalPosition.begin(),
-                     goalPosition.end(), sf::Vector2u{nx, ny})
-                      != goalPosition.end()) {
-                        board[ny][nx] = 'a';  // Restore goal under the box
-                    } else {
-                        board[ny][nx] = '.';  // Just floor under the box
-                    }
-
-                    // Move the box
-                    board[by][bx] = 'A';
-                    // Move player
-                    board[ny][nx] = '@';
-
-        // Restore the player’s previous position if it was on a goal
-                    if (std::find(goalPosition.begin(),
-                     goalPosition.end(), sf::Vector2u{px, py})
-                      != goalPosition.end()) {
-                        board[py][px] = 'a';  // Restore goal under player
-                    } else {
-                        board[py][px] = '.';  // Otherwise, just floor
-                    }
-
-                    // Update box position in the list
-                    for (auto& box : boxPos) {
-                        if (box.x == static_cast<unsigned>(nx) &&
-                            box.y == static_cast<unsigned>(ny)) {
-                            box.x = static_cast<unsigned>(bx);
-                            box.y = static_cast<unsigned>(by);
-                            break;
-                        }
-                    }
-
-                    playerPosition =
-                     {static_cast<unsigned>(nx), static_cast<unsigned>(ny)};
-                    moveCount++;
-                }
-            }
-        }
-        moveText.setString("Moves: " + std::to_string(moveCount));
+    SB_PROFILE_SCOPE("move");
+    if (!game.isLoaded()) {
+        return;  // no level loaded
+    }
+    renderer.face(dir);  // turns even when the move is blocked
+    dirty = true;
+    if (!game.move(dir)) {
+        return;
+    }
+    showMove(game.history()[game.historyPosition() - 1]);
+    updateStatus();
+    if (isWon()) {
+        hasWon = true;
     }
+}
+
+void Sokoban::showMoves(std::size_t from, std::size_t to) {
+    for (std::size_t i = std::min(from, to); i < std::max(from, to); ++i) {
+        showMove(game.history()[i]);
+    }
+}
+
+bool Sokoban::playPath(const std::vector<Direction>& path) {
+    std::size_t before = game.historyPosition();
+    if (!game.moveAll(path)) {
+        return false;
+    }
+    renderer.face(path.back());
+    showMoves(before, game.historyPosition());
+    updateStatus();
     if (isWon()) {
         hasWon = true;
     }
+    return true;
+}
+
+bool Sokoban::walkTo(unsigned int x, unsigned int y) {
+    const Board& board = game.board();
+    if (!game.isLoaded() || x >= board.width() || y >= board.height()) {
+        return false;
+    }
+    std::vector<Direction> path;
+    return planner.walkTo(game, board.index(x, y), path) && playPath(path);
+}
+
+bool Sokoban::pushBoxTo(sf::Vector2u box, sf::Vector2u target) {
+    const Board& board = game.board();
+    if (!game.isLoaded() || box.x >= board.width() || box.y >= board.height()
+     || target.x >= board.width() || target.y >= board.height()) {
+        return false;
+    }
+    std::vector<Direction> path;
+    return planner.pushTo(game, board.index(box.x, box.y),
+        board.index(target.x, target.y), path) && playPath(path);
 }
 
+void Sokoban::clickTile(unsigned int x, unsigned int y) {
+    const Board& board = game.board();
+    if (!game.isLoaded() || x >= board.width() || y >= board.height()) {
+        return;
+    }
+    sf::Vector2u tile(x, y);
+    dirty = true;
+    if (board.hasBox(board.index(x, y))) {
+        // clicking the selected box again drops the selection
+        selected = !(selected && selectedBox == tile);
+        selectedBox = tile;
+        selection.setPosition(x * TILE_SIZE + 2.f, y * TILE_SIZE + 2.f);
+    } else if (selected) {
+        selected = !pushBoxTo(selectedBox, tile);
+    } else {
+        walkTo(x, y);
+    }
+}
 
 void Sokoban::reset() {
-    board = originalBoard;
-    boxPos.clear();
-    moveCount = 0;
-    moveText.setString("Moves: 0");
+    game.reset();
+    selected = false;
+    hasWon = false;
+    updateStatus();
     timeText.setString("Time: 0s");
     gameClock.restart();
+    renderer.build(game.board(), getBoxes(), playerLoc());
+}
 
-    for (unsigned int y = 0; y < board.size(); y++) {
-        for (unsigned int x = 0; x < board[y].size(); x++) {
-            if (board[y][x] == '@') {
-                playerPosition = {x, y};
-            } else if (board[y][x] == 'A') {
-                boxPos.push_back({x, y});
-            }
-        }
+void Sokoban::undo() {
+    SB_PROFILE_SCOPE("undo");
+    std::size_t before = game.historyPosition();
+    if (game.undo()) {
+        selected = false;
+        showMoves(game.historyPosition(), before);
+        hasWon = isWon();
+        updateStatus();
     }
 }
 
-void Sokoban::undo() {
-    if (!undoStack.empty()) {
-        gameState prev = undoStack.top();
-        undoStack.pop();
-        board = prev.board;
-        playerPosition = prev.playerPosition;
-        boxPos = prev.boxPosition;
-        moveCount = prev.moveCount;
-        moveText.setString("Moves: " + std::to_string(moveCount));
+void Sokoban::redo() {
+    std::size_t before = game.historyPosition();
+    if (game.redo()) {
+        selected = false;
+        showMoves(before, game.historyPosition());
+        hasWon = isWon();
+        updateStatus();
     }
 }
 
+void Sokoban::jumpTo(std::size_t position) {
+    std::size_t before = game.historyPosition();
+    game.jumpTo(position);
+    selected = false;
+    showMoves(before, game.historyPosition());
+    hasWon = isWon();
+    updateStatus();
+}
+
+std::size_t Sokoban::historySize() const { return game.history().size(); }
+std::size_t Sokoban::historyPosition() const {
+    return game.historyPosition();
+}
+
 void Sokoban::draw(sf::RenderTarget& target, sf::RenderStates states) const {
-    for (unsigned int y = 0; y < o_height; ++y) {
-        for (unsigned int x = 0; x < o_width; ++x) {
-            char tile = board[y][x];
-            if (sprites.find(tile) != sprites.end()) {
-                sf::Sprite sprite = sprites.at(tile);
-                sprite.setPosition(x * TILE_SIZE, y * TILE_SIZE);
-                target.draw(sprite, states);
-            } else {
-                std::cerr << "No sprite found for tile: " << tile << std::endl;
-            }
-        }
+    SB_PROFILE_SCOPE("draw");
+    // The timer text only changes when the second does
+    int seconds = elapsedSeconds();
+    if (seconds != shownSecond) {
+        shownSecond = seconds;
+        timeText.setString("Time: " + std::to_string(seconds) + "s");
     }
+    dirty = false;
+    target.draw(renderer, states);
+    if (selected) {
+        target.draw(selection, states);
+    }
+    // The text stays put in window pixels while the camera scrolls
+    sf::View world = target.getView();
+    sf::Vector2f pixels(target.getSize());
+    target.setView(sf::View(sf::FloatRect(0.f, 0.f, pixels.x, pixels.y)));
     target.draw(moveText, states);
     if (hasWon) {
         target.draw(winText, states);
+    } else if (isDeadlocked()) {
+        target.draw(stuckText, states);
     }
-    sf::Time displayTime =
-     hasWon ? totalElapsedTime : gameClock.getElapsedTime();
-    timeText.setString
-    ("Time: " + std::to_string(static_cast<int>
-        (displayTime.asSeconds())) + "s");
     target.draw(timeText, states);
+    if (showProfile) {
+#ifdef SOKOBAN_PROFILE
+        profileText.setString(Profiler::instance().summary() + latencyLine);
+#else
+        profileText.setString("Built without SOKOBAN_PROFILE\n"
+            + latencyLine);
+#endif
+        target.draw(profileText, states);
+    }
+    target.setView(world);
 }
 
 std::ostream& operator<<(std::ostream& out, const Sokoban& s) {
@@ -291,44 +374,34 @@ std::ostream& operator<<(std::ostream& out, const Sokoban& s) {
 }
 
 std::istream& operator>>(std::istream& in, Sokoban& s) {
-    unsigned int width, height;
-    in >> height >> width;
-    s.setHeight(height);
-    s.setWidth(width);
-
-    std::vector<std::vector<char>> tempBoard(height, std::vector<char>(width));
-    std::vector<sf::Vector2u> tempBoxes;
-    sf::Vector2u tempPlayer;
-    std::vector<sf::Vector2u> tempGoals;
-
-    for (unsigned int y = 0; y < height; ++y) {
-        for (unsigned int x = 0; x < width; ++x) {
-            in >> tempBoard[y][x];
-            if (tempBoard[y][x] == '@') {
-                tempPlayer = {x, y};
-            } else if (tempBoard[y][x] == 'A') {
-                tempBoxes.push_back({x, y});
-            } else if (tempBoard[y][x] == 'a') {
-                tempGoals.push_back({x, y});
-            }
-        }
+    // On bad input the stream fails and s keeps whatever it had before
+    std::string text;
+    if (!nextLevelText(in, text)) {
+        return in;
     }
-
-    s.loadBoardState(tempBoard, tempPlayer, tempBoxes, tempGoals);
+    ParseResult result = parseLevels(text);
+    if (!result.ok() || result.levels.empty()) {
+        in.setstate(std::ios::failbit);
+        return in;
+    }
+    s.loadBoard(result.levels.front());
 
     return in;
 }
 
-void Sokoban::loadBoardState(
-const std::vector<std::vector<char>>& newBoard,
-const sf::Vector2u& newPlayerPos,
-const std::vector<sf::Vector2u>& newBoxPositions,
-const std::vector<sf::Vector2u>& newGoalPositions
-) {
-    board = newBoard;
-    playerPosition = newPlayerPos;
-    boxPos = newBoxPositions;
-    goalPosition = newGoalPositions;
+void Sokoban::loadBoard(const Board& level) {
+    loadState(GameState(level));
+}
+
+void Sokoban::loadState(GameState level) {
+    setHeight(level.board().height());
+    setWidth(level.board().width());
+    game = std::move(level);
+    hasWon = false;
+    selected = false;
+    updateStatus();
+    gameClock.restart();
+    renderer.build(game.board(), getBoxes(), playerLoc());
 }
 
 bool Sokoban::allowedTowalkOn(char tile) const {
@@ -336,8 +409,9 @@ bool Sokoban::allowedTowalkOn(char tile) const {
 }
 
 bool Sokoban::isGoalTile(unsigned int x, unsigned int y) const {
-    return std::find(goalPosition.begin(),
-    goalPosition.end(), sf::Vector2u{x, y}) != goalPosition.end();
+    const Board& board = game.board();
+    return x < board.width() && y < board.height()
+     && board.isGoal(board.index(x, y));
 }
 
 }  // namespace SB
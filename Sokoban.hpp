@@ -3,23 +3,16 @@
 #include <iostream>
 #include <string>
 #include <vector>
-#include <stack>  //  for undo
-#include <unordered_map>
 #include <SFML/Graphics.hpp>
+#include "Board.hpp"
+#include "BoardRenderer.hpp"
+#include "GameState.hpp"
+#include "PathPlanner.hpp"
 
 namespace SB {
-enum class Direction {
-    Up, Down, Left, Right
-};
-
-//  struct for undoing mvoes in the game
-struct gameState {
-    std::vector<std::vector<char>> board;
-    sf::Vector2u playerPosition;
-    std::vector<sf::Vector2u> boxPosition;
-    unsigned int moveCount;
-};
 
+//  SFML view of a GameState: textures, text and the clock live here, the
+//  rules and the move journal live in the state it wraps.
 class Sokoban : public sf::Drawable {
  public:
     static const int TILE_SIZE = 64;
@@ -35,12 +28,51 @@ class Sokoban : public sf::Drawable {
     sf::Vector2u playerLoc() const;
     char getTile(unsigned int x, unsigned int y) const;
     std::vector<sf::Vector2u> getBoxes() const;
+    std::vector<sf::Vector2u> getGoals() const;
+    const Board& getBoard() const;
+    const GameState& state() const;
     bool isWon() const;
+    //  The last move won the level (unlike isWon, does not touch the timer)
+    bool levelComplete() const { return hasWon; }
+    //  Time on the clock, stopped at the winning move
+    sf::Time playTime() const;
+    //  The level can no longer be won without undoing
+    bool isDeadlocked() const;
     void movePlayer(Direction dir);
+    //  Walks to the tile by the shortest path, as one undo step
+    bool walkTo(unsigned int x, unsigned int y);
+    //  Pushes the box at box onto target, as one undo step
+    bool pushBoxTo(sf::Vector2u box, sf::Vector2u target);
+    //  Mouse input: clicking a box selects it, clicking a tile then pushes
+    //  the selected box there. Without a selection the player walks.
+    void clickTile(unsigned int x, unsigned int y);
+    void clearSelection() { selected = false; dirty = true; }
+    //  Shows or hides the profiler readings under the timer
+    void toggleProfile() { showProfile = !showProfile; dirty = true; }
+    //  Extra line for the profiler overlay, e.g. input latency
+    void showLatency(const std::string& line);
+
+    //  Something on screen changed since the last draw: a move, a
+    //  selection, or the timer reaching a new second
+    bool needsRedraw() const;
+    //  How long the window can sleep before needsRedraw turns true on its
+    //  own (the next timer tick). Zero when a redraw is already due.
+    sf::Time untilRedraw() const;
+    //  Forces the next redraw, e.g. after the window was resized
+    void invalidate() { dirty = true; }
     void reset();
     void undo();
     void redo();
+    //  Undo or redo until the given number of journal moves are applied
+    void jumpTo(std::size_t position);
+    std::size_t historySize() const;
+    std::size_t historyPosition() const;
     void loadTexture(char tile, const std::string& filename);
+    //  Starts a new game on an already decoded level
+    void loadBoard(const Board& level);
+    //  Same, for a level already analysed elsewhere (see Session). Keeps
+    //  the fonts and textures, only the board is rebuilt.
+    void loadState(GameState level);
     friend std::istream& operator>>(std::istream& in, Sokoban& s);
 
  protected:
@@ -51,30 +83,36 @@ class Sokoban : public sf::Drawable {
     sf::Clock gameClock;
     mutable sf::Time totalElapsedTime;
     mutable sf::Text timeText;
-    std::unordered_map<char, sf::Texture> textures;
-    std::unordered_map<char, sf::Sprite> sprites;
+    mutable sf::Text profileText;
+    mutable bool dirty = true;
+    mutable int shownSecond = -1;  //  second the timer text shows
+    bool showProfile = false;
+    std::string latencyLine;
+    BoardRenderer renderer{TILE_SIZE};
     unsigned int o_height;
     unsigned int o_width;
     std::string s;
-    unsigned int moveCount = 0;
-    sf::Font font;
+    const sf::Font* font = nullptr;  //  owned by the AssetCache
     sf::Text moveText;
     std::string levelFilename;
     sf::Text winText;
+    sf::Text stuckText;
     bool hasWon = false;
-    std::stack<gameState> undoStack;
+    GameState game;
+    PathPlanner planner;
+    bool selected = false;
+    sf::Vector2u selectedBox;
+    sf::RectangleShape selection;
 
-    std::vector<std::vector<char>> board;
-    std::vector<std::vector<char>> originalBoard;
-    sf::Vector2u playerPosition;
-    std::vector<sf::Vector2u> boxPos;
-    std::vector<sf::Vector2u> goalPosition;
+    void setupText();
+    //  Puts the player and the box a journal entry moved back on screen
+    void showMove(const moveRecord& move);
+    //  Shows every journal entry between two history positions
+    void showMoves(std::size_t from, std::size_t to);
+    bool playPath(const std::vector<Direction>& path);
+    void updateStatus();
+    int elapsedSeconds() const;
 
-    void loadBoardState(
-        const std::vector<std::vector<char>>& newBoard,
-        const sf::Vector2u& newPlayerPos,
-        const std::vector<sf::Vector2u>& newBoxPositions,
-        const std::vector<sf::Vector2u>& newGoalPositions);
     // Check if player can step on tile
     bool allowedTowalkOn(char tile) const;
 
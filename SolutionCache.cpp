@@ -0,0 +1,277 @@
+//  Copyright 2025 <Orbosa Igbinovia> [legal/copyright]
+#include "SolutionCache.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include "Replay.hpp"
+
+namespace SB {
+
+namespace {
+constexpr char kMagic[4] = {'S', 'B', 'S', 'C'};
+constexpr std::size_t kHeaderSize = 8;
+constexpr std::size_t kRecordHeader = 8;
+constexpr std::size_t kFixedPayload = 60;
+
+uint64_t readLittle(const unsigned char* p, int bytes) {
+    uint64_t value = 0;
+    for (int i = bytes - 1; i >= 0; --i) {
+        value = (value << 8) | p[i];
+    }
+    return value;
+}
+
+void writeLittle(std::string& out, uint64_t value, int bytes) {
+    for (int i = 0; i < bytes; ++i) {
+        out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+uint32_t checksum(const unsigned char* p, std::size_t length) {
+    uint32_t hash = 2166136261u;  // FNV-1a
+    for (std::size_t i = 0; i < length; ++i) {
+        hash = (hash ^ p[i]) * 16777619u;
+    }
+    return hash;
+}
+
+std::string header() {
+    std::string out(kMagic, sizeof(kMagic));
+    writeLittle(out, SolutionCache::VERSION, 2);
+    writeLittle(out, 0, 2);
+    return out;
+}
+
+std::string encode(const CacheEntry& e) {
+    std::string payload;
+    writeLittle(payload, e.key, 8);
+    writeLittle(payload, e.status, 1);
+    writeLittle(payload, 0, 3);
+    writeLittle(payload, e.moves, 4);
+    writeLittle(payload, e.pushes, 4);
+    writeLittle(payload, e.wins, 4);
+    writeLittle(payload, e.nodes, 8);
+    writeLittle(payload, e.budget, 8);
+    writeLittle(payload, std::llround(e.solveSeconds * 1e6), 8);
+    writeLittle(payload, std::llround(e.bestSeconds * 1e3), 8);
+    writeLittle(payload, e.solution.size(), 4);
+    payload += e.solution;
+
+    std::string record;
+    writeLittle(record, payload.size(), 4);
+    writeLittle(record, checksum(reinterpret_cast<const unsigned char*>(
+        payload.data()), payload.size()), 4);
+    return record + payload;
+}
+
+// Fills e from a payload whose size and checksum were already checked
+bool decode(const unsigned char* p, std::size_t size, CacheEntry& e) {
+    if (size < kFixedPayload || p[8] > CacheEntry::OutOfBudget) {
+        return false;
+    }
+    std::size_t length = readLittle(p + 56, 4);
+    if (kFixedPayload + length != size) {
+        return false;
+    }
+    e.key = readLittle(p, 8);
+    e.status = static_cast<CacheEntry::Status>(p[8]);
+    e.moves = static_cast<unsigned int>(readLittle(p + 12, 4));
+    e.pushes = static_cast<unsigned int>(readLittle(p + 16, 4));
+    e.wins = static_cast<unsigned int>(readLittle(p + 20, 4));
+    e.nodes = readLittle(p + 24, 8);
+    e.budget = readLittle(p + 32, 8);
+    e.solveSeconds = readLittle(p + 40, 8) / 1e6;
+    e.bestSeconds = readLittle(p + 48, 8) / 1e3;
+    e.solution.assign(reinterpret_cast<const char*>(p + kFixedPayload),
+        length);
+    return true;
+}
+}  // namespace
+
+uint64_t levelKey(const Board& level) {
+    uint64_t hash = 14695981039346656037ull;  // FNV-1a
+    auto mix = [&hash](uint64_t value) {
+        hash = (hash ^ value) * 1099511628211ull;
+    };
+    mix(level.width());
+    mix(level.height());
+    for (unsigned int y = 0; y < level.height(); ++y) {
+        for (unsigned int x = 0; x < level.width(); ++x) {
+            std::size_t i = level.index(x, y);
+            mix(level.terrain(i) * 4u + level.piece(i));
+        }
+    }
+    return hash;
+}
+
+void CacheEntry::merge(const CacheEntry& update) {
+    key = update.key;
+    if (!update.solution.empty() && (solution.empty()
+     || update.moves < moves
+     || (update.moves == moves && update.pushes < pushes))) {
+        solution = update.solution;
+        moves = update.moves;
+        pushes = update.pushes;
+    }
+    // A proof beats running out of budget, and a bigger budget beats a
+    // smaller one
+    bool final = status == Solved || status == Unsolvable;
+    bool newFinal = update.status == Solved || update.status == Unsolvable;
+    if ((newFinal && !final) || (update.status == OutOfBudget
+     && (status == Unknown || (status == OutOfBudget
+        && update.budget > budget)))) {
+        status = update.status;
+        nodes = update.nodes;
+        budget = update.budget;
+        solveSeconds = update.solveSeconds;
+    }
+    if (!solution.empty()) {
+        status = Solved;  // a player's win proves it too
+    }
+    wins += update.wins;
+    if (update.bestSeconds > 0
+     && (bestSeconds == 0 || update.bestSeconds < bestSeconds)) {
+        bestSeconds = update.bestSeconds;
+    }
+}
+
+SolutionCache::SolutionCache(std::string filename)
+    : path(std::move(filename)) {}
+
+void SolutionCache::load() {
+    // A file that is not ours stays unread and unwritten
+    if (!failure.empty()) throw std::runtime_error(failure);
+    if (loaded) return;
+    std::ifstream in(path, std::ios::binary);
+    std::string bytes;
+    if (in) {
+        bytes.assign(std::istreambuf_iterator<char>(in),
+            std::istreambuf_iterator<char>());
+    }
+    if (bytes.empty()) {  // no file yet
+        loaded = true;
+        return;
+    }
+    if (bytes.size() < kHeaderSize || bytes.compare(0, 4, kMagic, 4) != 0) {
+        failure = "Not a solution cache: " + path;
+        throw std::runtime_error(failure);
+    }
+    auto data = reinterpret_cast<const unsigned char*>(bytes.data());
+    if (readLittle(data + 4, 2) != VERSION) {
+        failure = "Unsupported solution cache version: " + path;
+        throw std::runtime_error(failure);
+    }
+    std::size_t at = kHeaderSize;
+    while (bytes.size() - at >= kRecordHeader) {
+        std::size_t size = readLittle(data + at, 4);
+        if (bytes.size() - at - kRecordHeader < size
+         || checksum(data + at + kRecordHeader, size)
+            != readLittle(data + at + 4, 4)) {
+            break;
+        }
+        CacheEntry entry;
+        if (!decode(data + at + kRecordHeader, size, entry)) break;
+        stale += index.count(entry.key);
+        index[entry.key] = std::move(entry);
+        at += kRecordHeader + size;
+    }
+    validEnd = at;
+    loaded = true;
+}
+
+void SolutionCache::append(const std::string& bytes) {
+    std::string out = bytes;
+    std::ios::openmode mode = std::ios::binary | std::ios::app;
+    if (validEnd == 0) {
+        out = header() + bytes;
+        mode = std::ios::binary | std::ios::trunc;
+    } else if (std::filesystem::file_size(path) != validEnd) {
+        std::filesystem::resize_file(path, validEnd);  // torn record
+    }
+    std::ofstream file(path, mode);
+    file.write(out.data(), static_cast<std::streamsize>(out.size()));
+    file.flush();
+    if (!file) {
+        throw std::runtime_error("Unable to write file: " + path);
+    }
+    validEnd += out.size();
+}
+
+std::optional<CacheEntry> SolutionCache::find(uint64_t key) {
+    std::lock_guard<std::mutex> guard(lock);
+    load();
+    auto it = index.find(key);
+    if (it == index.end()) return std::nullopt;
+    return it->second;
+}
+
+CacheEntry SolutionCache::record(const Board& level,
+ const CacheEntry& entry) {
+    if (entry.key != levelKey(level)) {
+        throw std::invalid_argument("Cache entry is for another level");
+    }
+    CacheEntry checked = entry;
+    if (!checked.solution.empty()) {
+        Replay replay{GameState(level)};
+        if (!replay.play(checked.solution) || !replay.solves()) {
+            throw std::invalid_argument(
+                "Cached solution does not solve the level");
+        }
+        checked.solution = toLurd(replay.state());
+        checked.moves = static_cast<unsigned int>(checked.solution.size());
+        checked.pushes = static_cast<unsigned int>(std::count_if(
+            checked.solution.begin(), checked.solution.end(),
+            [](unsigned char c) { return std::isupper(c); }));
+    } else if (checked.status == CacheEntry::Solved) {
+        throw std::invalid_argument("Solved cache entry has no solution");
+    }
+    std::lock_guard<std::mutex> guard(lock);
+    load();
+    CacheEntry merged;
+    auto it = index.find(checked.key);
+    if (it != index.end()) merged = it->second;
+    merged.merge(checked);
+    append(encode(merged));
+    stale += it != index.end();
+    index[checked.key] = merged;
+    return merged;
+}
+
+std::size_t SolutionCache::size() {
+    std::lock_guard<std::mutex> guard(lock);
+    load();
+    return index.size();
+}
+
+std::size_t SolutionCache::superseded() {
+    std::lock_guard<std::mutex> guard(lock);
+    load();
+    return stale;
+}
+
+void SolutionCache::compact() {
+    std::lock_guard<std::mutex> guard(lock);
+    load();
+    std::string bytes = header();
+    for (const auto& [key, entry] : index) {
+        bytes += encode(entry);
+    }
+    std::string temp = path + ".tmp";
+    {
+        std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+        file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        if (!file) {
+            throw std::runtime_error("Unable to write file: " + temp);
+        }
+    }
+    std::filesystem::rename(temp, path);
+    validEnd = bytes.size();
+    stale = 0;
+}
+
+}  // namespace SB
@@ -0,0 +1,93 @@
+//  Copyright 2025 <Orbosa Igbinovia> [legal/copyright]
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include "Board.hpp"
+
+namespace SB {
+
+//  Content hash of a level as parsed: size, walls, goals, boxes and the
+//  player. Levels that look the same share a key wherever they came from.
+uint64_t levelKey(const Board& level);
+
+//  What is known about one level
+struct CacheEntry {
+    enum Status : uint8_t { Unknown, Solved, Unsolvable, OutOfBudget };
+
+    uint64_t key = 0;
+    Status status = Unknown;
+    //  Best known solution as LURD, fewest moves then fewest pushes,
+    //  from the solver or from a player. Empty when there is none.
+    std::string solution;
+    unsigned int moves = 0;
+    unsigned int pushes = 0;
+    //  Solver effort behind status. OutOfBudget is only final for
+    //  budgets up to the one recorded.
+    uint64_t nodes = 0;
+    uint64_t budget = 0;
+    double solveSeconds = 0.0;
+    //  Games won, and the fastest of them (0 when never won)
+    unsigned int wins = 0;
+    double bestSeconds = 0.0;
+
+    //  Folds newer knowledge in, keeping the best of both. A solution is
+    //  taken as proof the level is solved, so it must have been replayed
+    //  first (SolutionCache::record does).
+    void merge(const CacheEntry& update);
+};
+
+//  Append-only file of CacheEntry records. Nothing is read until the first
+//  lookup, which loads the whole file into an in-memory index; after that
+//  every record() appends one record, and the last record for a key wins.
+//  A record cut short by a crash is dropped on load and written over.
+//  Records left behind by a newer one for the same key are counted, and
+//  the owner calls compact() when they outnumber the keys. A file that
+//  is not a cache of this version is left alone: every call throws
+//  std::runtime_error and nothing is written. Safe to share between
+//  threads.
+//
+//  Layout (little endian):
+//    "SBSC"  u16 version  u16 reserved
+//    records: u32 payloadSize  u32 checksum  payload
+//    payload: u64 key  u8 status  u8[3] reserved  u32 moves  u32 pushes
+//             u32 wins  u64 nodes  u64 budget  u64 solveMicros
+//             u64 bestMillis  u32 solutionLength  solution bytes
+class SolutionCache {
+ public:
+    static constexpr uint16_t VERSION = 1;
+
+    explicit SolutionCache(std::string filename);
+
+    std::optional<CacheEntry> find(uint64_t key);
+    //  Replays the entry's solution on level, takes its moves and pushes
+    //  from the replay, merges the entry into what is known and appends
+    //  the result. Throws std::invalid_argument when the key is not
+    //  level's, the solution does not solve it or a Solved entry has no
+    //  solution, and std::runtime_error when the file cannot be written.
+    CacheEntry record(const Board& level, const CacheEntry& entry);
+    //  Keys in the index (loads it)
+    std::size_t size();
+    //  Records in the file that a later one for the same key replaced
+    std::size_t superseded();
+    //  Rewrites the file with one record per key
+    void compact();
+    const std::string& filename() const { return path; }
+
+ private:
+    std::string path;
+    std::mutex lock;
+    bool loaded = false;
+    std::string failure;  //  set when the file is not a cache we read
+    std::size_t validEnd = 0;  //  file length up to the last whole record
+    std::unordered_map<uint64_t, CacheEntry> index;
+    std::size_t stale = 0;  //  superseded records in the file
+
+    void load();
+    void append(const std::string& bytes);
+};
+
+}  // namespace SB
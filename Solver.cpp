@@ -0,0 +1,1032 @@
+//  Copyright 2025 <Orbosa Igbinovia> [legal/copyright]
+#include "Solver.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <new>
+#include <queue>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include "Profiler.hpp"
+
+namespace SB {
+
+namespace {
+constexpr unsigned int kInfinity = 1000000;
+constexpr uint32_t kNoParent = 0xFFFFFFFF;
+// Held by another search of the portfolio
+constexpr uint32_t kTaken = 0xFFFFFFFE;
+
+// Hungarian algorithm on a rows x cols matrix (rows <= cols), stored flat.
+// Returns the cost of the cheapest assignment of every row to its own column.
+unsigned int minimumMatching(const std::vector<unsigned int>& cost,
+ std::size_t rows, std::size_t cols) {
+    const long long inf = static_cast<long long>(kInfinity) * kInfinity;
+    std::vector<long long> u(rows + 1, 0), v(cols + 1, 0);
+    std::vector<std::size_t> match(cols + 1, 0), way(cols + 1, 0);
+    for (std::size_t i = 1; i <= rows; ++i) {
+        match[0] = i;
+        std::size_t j0 = 0;
+        std::vector<long long> minv(cols + 1, inf);
+        std::vector<char> used(cols + 1, 0);
+        do {
+            used[j0] = 1;
+            std::size_t i0 = match[j0], j1 = 0;
+            long long delta = inf;
+            for (std::size_t j = 1; j <= cols; ++j) {
+                if (used[j]) continue;
+                long long cur = cost[(i0 - 1) * cols + (j - 1)] - u[i0] - v[j];
+                if (cur < minv[j]) {
+                    minv[j] = cur;
+                    way[j] = j0;
+                }
+                if (minv[j] < delta) {
+                    delta = minv[j];
+                    j1 = j;
+                }
+            }
+            for (std::size_t j = 0; j <= cols; ++j) {
+                if (used[j]) {
+                    u[match[j]] += delta;
+                    v[j] -= delta;
+                } else {
+                    minv[j] -= delta;
+                }
+            }
+            j0 = j1;
+        } while (match[j0] != 0);
+        do {
+            std::size_t j1 = way[j0];
+            match[j0] = match[j1];
+            j0 = j1;
+        } while (j0 != 0);
+    }
+    long long total = 0;
+    for (std::size_t j = 1; j <= cols; ++j) {
+        if (match[j] != 0) {
+            total += cost[(match[j] - 1) * cols + (j - 1)];
+        }
+    }
+    return total >= kInfinity ? kInfinity : static_cast<unsigned int>(total);
+}
+
+// Open addressing map from a position hash to the node holding it. Two
+// positions can share a hash, so lookups take a check that compares the
+// packed squares.
+class NodeIndex {
+ public:
+    template <class Same>
+    uint32_t find(uint64_t hash, Same same) const {
+        if (nodes.empty()) return kNoParent;
+        for (std::size_t i = hash & mask;; i = (i + 1) & mask) {
+            if (nodes[i] == kNoParent) return kNoParent;
+            if (hashes[i] == hash && same(nodes[i])) return nodes[i];
+        }
+    }
+    void insert(uint64_t hash, uint32_t node) {
+        if (2 * (used + 1) > nodes.size()) grow();
+        place(hash, node);
+        ++used;
+    }
+
+ private:
+    std::vector<uint64_t> hashes;
+    std::vector<uint32_t> nodes;  //  kNoParent marks an empty slot
+    std::size_t mask = 0;
+    std::size_t used = 0;
+
+    void place(uint64_t hash, uint32_t node) {
+        std::size_t i = hash & mask;
+        while (nodes[i] != kNoParent) i = (i + 1) & mask;
+        hashes[i] = hash;
+        nodes[i] = node;
+    }
+    void grow() {
+        std::vector<uint64_t> oldHashes = std::move(hashes);
+        std::vector<uint32_t> oldNodes = std::move(nodes);
+        std::size_t size = std::max<std::size_t>(1024, 2 * oldNodes.size());
+        hashes.assign(size, 0);
+        nodes.assign(size, kNoParent);
+        mask = size - 1;
+        for (std::size_t i = 0; i < oldNodes.size(); ++i) {
+            if (oldNodes[i] != kNoParent) place(oldHashes[i], oldNodes[i]);
+        }
+    }
+};
+
+// Positions reached by the portfolio's searches, shared without locks,
+// and the visited check of every search. A slot is three words: the
+// position's hash, then the search and node that reached it first going
+// forward and going backward. Slots are claimed with compare and swap.
+// A position is known here by its 64-bit hash alone.
+//
+// The words come from calloc, so pages the searches never reach are
+// never touched. A hash whose probes all find other hashes is not
+// shared: its search keeps it to itself.
+class SharedTable {
+ public:
+    // What claim() found in the slot
+    struct Claim {
+        bool placed = false;  //  false when the table had no room
+        uint64_t owner = 0;  //  this side's, 0 if the caller claimed it
+        uint64_t other = 0;  //  the other side's, 0 if none yet
+    };
+
+    explicit SharedTable(std::size_t positions)
+        : slots(capacity(positions)), mask(slots - 1),
+          words(static_cast<uint64_t*>(std::calloc(3 * slots, 8)),
+              &std::free) {
+        if (!words) throw std::bad_alloc();
+    }
+
+    // Names node of run in a slot, where 0 means nobody
+    static uint64_t owner(int run, uint32_t node) {
+        return (static_cast<uint64_t>(run) + 1) << 32 | node;
+    }
+
+    // Claims the position for owner on side (0 forward, 1 backward)
+    // unless someone on that side holds it already
+    Claim claim(uint64_t hash, int side, uint64_t owner) {
+        const uint64_t tag = hash | 1;
+        for (std::size_t probe = 0; probe < 64; ++probe) {
+            uint64_t* slot = &words[3 * ((hash + probe) & mask)];
+            std::atomic_ref<uint64_t> key(slot[0]);
+            uint64_t seen = key.load(std::memory_order_acquire);
+            if (seen == 0) key.compare_exchange_strong(seen, tag);
+            // seen is now the slot's hash, perhaps one that just won
+            if (seen != 0 && seen != tag) continue;
+            Claim claim;
+            claim.placed = true;
+            std::atomic_ref<uint64_t>(slot[1 + side])
+                .compare_exchange_strong(claim.owner, owner);
+            claim.other = std::atomic_ref<uint64_t>(slot[2 - side]).load();
+            return claim;
+        }
+        return Claim();
+    }
+
+ private:
+    std::size_t slots;
+    std::size_t mask;
+    std::unique_ptr<uint64_t[], decltype(&std::free)> words;
+
+    static std::size_t capacity(std::size_t positions) {
+        std::size_t size = 64;
+        while (size < 2 * positions) size <<= 1;
+        return size;
+    }
+};
+}  // namespace
+
+// Nodes of one best-first search. Node i's position is packed at
+// positions[i * width]; a reopened node only changes its player square.
+struct Solver::Graph {
+    struct Node {
+        uint32_t parent;
+        unsigned int g;
+        unsigned int h;
+        Step via;
+        uint16_t region;  //  the player square hashed for the node
+        bool closed;
+    };
+
+    std::size_t width = 1;
+    std::vector<Node> nodes;
+    std::vector<uint16_t> positions;
+    NodeIndex index;
+
+    const uint16_t* at(uint32_t node) const {
+        return &positions[node * width];
+    }
+    // The node holding position, or kNoParent
+    uint32_t find(const uint16_t* position, uint16_t region,
+     uint64_t hash) const {
+        return index.find(hash, [&](uint32_t node) {
+            return holds(node, position, region);
+        });
+    }
+    // Appends a node without indexing it
+    uint32_t push(const uint16_t* position, uint16_t region, Node node) {
+        uint32_t id = static_cast<uint32_t>(nodes.size());
+        node.region = region;
+        nodes.push_back(node);
+        positions.insert(positions.end(), position, position + width);
+        return id;
+    }
+    uint32_t add(const uint16_t* position, uint16_t region, uint64_t hash,
+     Node node) {
+        uint32_t id = push(position, region, node);
+        index.insert(hash, id);
+        return id;
+    }
+    bool holds(uint32_t node, const uint16_t* position,
+     uint16_t region) const {
+        return nodes[node].region == region
+            && std::equal(position + 1, position + width, at(node) + 1);
+    }
+};
+
+struct Solver::Run {
+    int id = 0;
+    bool backward = false;
+    unsigned int weight = 1;  //  f = g + weight * h
+    std::string name;
+    //  Heuristic rows: goals going forward, start squares going back
+    const std::vector<std::vector<unsigned int>>* targets = nullptr;
+    SharedTable* shared = nullptr;
+    std::atomic<int>* winner = nullptr;  //  id of the run that finished
+    //  Runs on this side that have not run out of positions
+    std::atomic<int>* left = nullptr;
+
+    Graph graph;
+    std::size_t expanded = 0;
+    bool exhausted = false;  //  searched everything: no solution
+    uint32_t endNode = kNoParent;  //  the goal, the start or a meeting
+    //  Set when it met the other side: SharedTable::owner of the node
+    //  there
+    uint64_t meeting = 0;
+    std::exception_ptr failure;
+};
+
+Solver::Solver(const GameState& level)
+    : stride(level.board().stride()), deadlocks(level.deadlocks()),
+      zobrist(level.board().size()) {
+    const Board& board = level.board();
+    if (board.size() > 0xFFFF) {
+        throw std::length_error("Level is too large for the solver");
+    }
+    // The solver shares the board's padded layout, so indices carry over
+    for (Direction dir : {Direction::Up, Direction::Down,
+     Direction::Left, Direction::Right}) {
+        offset[static_cast<int>(dir)] = static_cast<int>(board.step(dir));
+    }
+    walls.assign(board.size(), 0);
+    start.assign(1, 0);
+    for (std::size_t i = 0; i < board.size(); ++i) {
+        walls[i] = board.isWall(i);
+        if (board.isGoal(i)) goals.push_back(static_cast<uint16_t>(i));
+        if (board.hasBox(i)) start.push_back(static_cast<uint16_t>(i));
+        if (board.piece(i) == Board::Player) {
+            start[0] = static_cast<uint16_t>(i);
+        }
+    }
+    width = start.size();
+    computeDistances();
+}
+
+uint16_t Solver::square(unsigned int x, unsigned int y) const {
+    return static_cast<uint16_t>((y + 1) * stride + (x + 1));
+}
+
+bool Solver::isDeadSquare(unsigned int x, unsigned int y) const {
+    if (x + 2 >= stride || square(x, y) >= walls.size()) {
+        return true;
+    }
+    return deadlocks.isDeadSquare(square(x, y));
+}
+
+unsigned int Solver::lowerBound() const {
+    return heuristic(start.data() + 1);
+}
+
+// Push distance from every square to every goal, ignoring the other boxes.
+// Found by pulling a box backwards out of each goal.
+void Solver::computeDistances() {
+    distance.assign(goals.size(),
+     std::vector<unsigned int>(walls.size(), kInfinity));
+    std::vector<uint16_t> queue;
+    for (std::size_t g = 0; g < goals.size(); ++g) {
+        std::vector<unsigned int>& dist = distance[g];
+        queue.assign(1, goals[g]);
+        dist[goals[g]] = 0;
+        for (std::size_t head = 0; head < queue.size(); ++head) {
+            uint16_t box = queue[head];
+            for (int d : offset) {
+                int from = box - d, player = box - 2 * d;
+                if (player < 0 || player >= static_cast<int>(walls.size())
+                 || walls[from] || walls[player]
+                 || dist[from] != kInfinity) {
+                    continue;
+                }
+                dist[from] = dist[box] + 1;
+                queue.push_back(static_cast<uint16_t>(from));
+            }
+        }
+    }
+}
+
+Solver::Scratch Solver::newScratch() const {
+    Scratch scratch;
+    scratch.occupied.assign(walls.size(), 0);
+    scratch.mark.assign(walls.size(), 0);
+    scratch.parent.assign(walls.size(), 0);
+    return scratch;
+}
+
+unsigned int Solver::heuristic(const uint16_t* boxes) const {
+    return matchCost(boxes, distance);
+}
+
+unsigned int Solver::matchCost(const uint16_t* boxes,
+ const std::vector<std::vector<unsigned int>>& table) const {
+    // Match whichever side is smaller, that is what the win check needs
+    std::size_t count = boxCount();
+    std::size_t targets = table.size();
+    bool boxRows = count <= targets;
+    std::size_t rows = boxRows ? count : targets;
+    std::size_t cols = boxRows ? targets : count;
+    if (rows == 0) {
+        return 0;
+    }
+    std::vector<unsigned int> cost(rows * cols);
+    for (std::size_t b = 0; b < count; ++b) {
+        for (std::size_t g = 0; g < targets; ++g) {
+            unsigned int c = table[g][boxes[b]];
+            if (boxRows) {
+                cost[b * cols + g] = c;
+            } else {
+                cost[g * cols + b] = c;
+            }
+        }
+    }
+    return minimumMatching(cost, rows, cols);
+}
+
+void Solver::occupy(const uint16_t* position, Scratch& scratch,
+ char value) const {
+    for (std::size_t i = 1; i < width; ++i) {
+        scratch.occupied[position[i]] = value;
+    }
+}
+
+// Marks every square the player can walk to and leaves them in
+// scratch.queue. Boxes must be placed in scratch.occupied first.
+void Solver::floodFill(uint16_t player, Scratch& scratch) const {
+    ++scratch.stamp;
+    scratch.queue.assign(1, player);
+    scratch.mark[player] = scratch.stamp;
+    for (std::size_t head = 0; head < scratch.queue.size(); ++head) {
+        uint16_t sq = scratch.queue[head];
+        for (int d : offset) {
+            uint16_t next = static_cast<uint16_t>(sq + d);
+            if (walls[next] || scratch.occupied[next]
+             || scratch.mark[next] == scratch.stamp) {
+                continue;
+            }
+            scratch.mark[next] = scratch.stamp;
+            scratch.queue.push_back(next);
+        }
+    }
+}
+
+uint16_t Solver::region(const uint16_t* position, SolveMode mode,
+ Scratch& scratch) const {
+    if (mode != SolveMode::Pushes) {
+        return position[0];
+    }
+    occupy(position, scratch, 1);
+    floodFill(position[0], scratch);
+    occupy(position, scratch, 0);
+    return *std::min_element(scratch.queue.begin(), scratch.queue.end());
+}
+
+uint64_t Solver::hash(const uint16_t* position, uint16_t region) const {
+    uint64_t h = zobrist.player(region);
+    for (std::size_t i = 1; i < width; ++i) {
+        h ^= zobrist.box(position[i]);
+    }
+    return h;
+}
+
+// Dead squares, freezes and frozen corrals around the pushed box. With
+// spare boxes a stuck box is only a spare, so nothing is pruned.
+bool Solver::losesLevel(uint16_t from, uint16_t to, Scratch& scratch) const {
+    if (!deadlocks.everyBoxCounts()) {
+        return false;
+    }
+    scratch.occupied[from] = 0;
+    scratch.occupied[to] = 1;
+    bool lost = deadlocks.afterPush(to, from,
+        [&scratch](std::size_t sq) { return scratch.occupied[sq] != 0; },
+        scratch.corral);
+    scratch.occupied[to] = 0;
+    scratch.occupied[from] = 1;
+    if (lost) SB_PROFILE_COUNT("solver_prune");
+    return lost;
+}
+
+void Solver::addChild(const uint16_t* position, std::size_t i, uint16_t to,
+ uint16_t player, Step step, Children& out) const {
+    std::size_t first = out.positions.size();
+    out.positions.insert(out.positions.end(), position, position + width);
+    uint16_t* child = &out.positions[first];
+    child[0] = player;
+    // Slide the moved box along until the boxes are sorted again
+    uint16_t* boxes = child + 1;
+    while (i > 0 && boxes[i - 1] > to) {
+        boxes[i] = boxes[i - 1];
+        --i;
+    }
+    while (i + 1 < boxCount() && boxes[i + 1] < to) {
+        boxes[i] = boxes[i + 1];
+        ++i;
+    }
+    boxes[i] = to;
+    out.steps.push_back(step);
+}
+
+void Solver::expand(const uint16_t* position, SolveMode mode,
+ Scratch& scratch, Children& out) const {
+    out.positions.clear();
+    out.steps.clear();
+    const uint16_t* boxes = position + 1;
+    occupy(position, scratch, 1);
+
+    if (mode == SolveMode::Pushes) {
+        floodFill(position[0], scratch);
+        for (std::size_t i = 0; i < boxCount(); ++i) {
+            uint16_t box = boxes[i];
+            for (int d = 0; d < 4; ++d) {
+                uint16_t from = static_cast<uint16_t>(box - offset[d]);
+                uint16_t to = static_cast<uint16_t>(box + offset[d]);
+                if (scratch.mark[from] != scratch.stamp || walls[to]
+                 || scratch.occupied[to] || losesLevel(box, to, scratch)) {
+                    continue;
+                }
+                addChild(position, i, to, box,
+                    {box, static_cast<Direction>(d)}, out);
+            }
+        }
+    } else {
+        for (int d = 0; d < 4; ++d) {
+            uint16_t next = static_cast<uint16_t>(position[0] + offset[d]);
+            if (walls[next]) continue;
+            if (!scratch.occupied[next]) {
+                out.positions.insert(out.positions.end(), position,
+                    position + width);
+                out.positions[out.positions.size() - width] = next;
+                out.steps.push_back({0, static_cast<Direction>(d)});
+                continue;
+            }
+            uint16_t to = static_cast<uint16_t>(next + offset[d]);
+            if (walls[to] || scratch.occupied[to]
+             || losesLevel(next, to, scratch)) {
+                continue;
+            }
+            std::size_t i = std::lower_bound(boxes, boxes + boxCount(), next)
+                - boxes;
+            addChild(position, i, to, next,
+                {next, static_cast<Direction>(d)}, out);
+        }
+    }
+
+    occupy(position, scratch, 0);
+}
+
+// Shortest walk for the player to target without moving any box
+bool Solver::walk(const uint16_t* position, uint16_t target,
+ Scratch& scratch, std::vector<Direction>& steps) const {
+    steps.clear();
+    occupy(position, scratch, 1);
+    ++scratch.stamp;
+    scratch.queue.assign(1, position[0]);
+    scratch.mark[position[0]] = scratch.stamp;
+    for (std::size_t head = 0; head < scratch.queue.size()
+     && scratch.mark[target] != scratch.stamp; ++head) {
+        uint16_t sq = scratch.queue[head];
+        for (int d : offset) {
+            uint16_t next = static_cast<uint16_t>(sq + d);
+            if (walls[next] || scratch.occupied[next]
+             || scratch.mark[next] == scratch.stamp) {
+                continue;
+            }
+            scratch.mark[next] = scratch.stamp;
+            scratch.parent[next] = sq;
+            scratch.queue.push_back(next);
+        }
+    }
+    occupy(position, scratch, 0);
+    if (scratch.mark[target] != scratch.stamp) {
+        return false;  // parent[] only holds this walk's squares
+    }
+
+    for (uint16_t sq = target; sq != position[0]; sq = scratch.parent[sq]) {
+        int d = std::find(offset, offset + 4, sq - scratch.parent[sq]) - offset;
+        steps.push_back(static_cast<Direction>(d));
+    }
+    std::reverse(steps.begin(), steps.end());
+    return true;
+}
+
+// Turns the steps of a found path into the full list of player steps
+void Solver::finish(const Path& path, SolveResult& result,
+ Scratch& scratch) const {
+    result.solved = true;
+    const uint16_t* current = start.data();
+    std::vector<Direction> steps;
+    for (std::size_t k = 0; k < path.steps.size(); ++k) {
+        const Step& step = path.steps[k];
+        // A push-mode step jumps the player, so walk up to the box
+        if (step.box != 0) {
+            uint16_t behind = static_cast<uint16_t>(
+                step.box - offset[static_cast<int>(step.dir)]);
+            if (behind != current[0]) {
+                if (!walk(current, behind, scratch, steps)) {
+                    throw std::logic_error("solver path pushes a box from "
+                        "a square the player cannot reach");
+                }
+                result.moves.insert(result.moves.end(),
+                    steps.begin(), steps.end());
+            }
+            ++result.pushes;
+        }
+        result.moves.push_back(step.dir);
+        current = &path.positions[k * width];
+    }
+}
+
+void Solver::trace(const Graph& graph, uint32_t node, Path& path) const {
+    std::vector<uint32_t> chain;
+    for (uint32_t n = node; graph.nodes[n].parent != kNoParent;
+     n = graph.nodes[n].parent) {
+        chain.push_back(n);
+    }
+    for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+        path.steps.push_back(graph.nodes[*it].via);
+        path.positions.insert(path.positions.end(), graph.at(*it),
+            graph.at(*it) + width);
+    }
+}
+
+SolveResult Solver::solve(const SolverOptions& options) const {
+    SolveResult result;
+    auto begin = std::chrono::steady_clock::now();
+    if (options.algorithm == SearchAlgorithm::IDAStar) {
+        idaStar(options, result);
+    } else if (options.algorithm == SearchAlgorithm::Portfolio) {
+        portfolio(options, result);
+    } else {
+        aStar(options, result);
+    }
+    result.seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - begin).count();
+    if (result.seconds > 0.0) {
+        result.nodesPerSecond = result.nodesExpanded / result.seconds;
+    }
+    return result;
+}
+
+void Solver::aStar(const SolverOptions& options, SolveResult& result) const {
+    struct Entry {
+        unsigned int f;
+        unsigned int h;
+        unsigned int g;
+        uint32_t node;
+    };
+    // Lowest f first, ties broken towards the deeper node
+    auto worse = [](const Entry& a, const Entry& b) {
+        return a.f != b.f ? a.f > b.f : a.h > b.h;
+    };
+    std::priority_queue<Entry, std::vector<Entry>, decltype(worse)> open(worse);
+    Graph graph;
+    graph.width = width;
+    Children children;
+    Scratch scratch = newScratch();
+
+    unsigned int h = heuristic(start.data() + 1);
+    if (h >= kInfinity) return;
+    uint16_t r = region(start.data(), options.mode, scratch);
+    graph.add(start.data(), r, hash(start.data(), r),
+        {kNoParent, 0, h, Step{0, Direction::Up}, 0, false});
+    open.push({h, h, 0, 0});
+
+    while (!open.empty()) {
+        Entry top = open.top();
+        open.pop();
+        Graph::Node& node = graph.nodes[top.node];
+        if (node.closed || top.g != node.g) continue;
+        if (top.h == 0) {
+            Path path;
+            trace(graph, top.node, path);
+            finish(path, result, scratch);
+            return;
+        }
+        if (result.nodesExpanded >= options.maxNodes) {
+            result.outOfBudget = true;
+            return;
+        }
+        node.closed = true;
+        ++result.nodesExpanded;
+
+        expand(graph.at(top.node), options.mode, scratch, children);
+        unsigned int g = top.g + 1;
+        for (std::size_t k = 0; k < children.steps.size(); ++k) {
+            const uint16_t* child = &children.positions[k * width];
+            r = region(child, options.mode, scratch);
+            uint64_t key = hash(child, r);
+            uint32_t known = graph.find(child, r, key);
+            if (known == kNoParent) {
+                h = heuristic(child + 1);
+                // Unsolvable positions stay in the graph as closed nodes
+                uint32_t added = graph.add(child, r, key,
+                    {top.node, g, h, children.steps[k], 0, h >= kInfinity});
+                if (h < kInfinity) open.push({g + h, h, g, added});
+                continue;
+            }
+            Graph::Node& old = graph.nodes[known];
+            if (old.closed || old.g <= g) continue;
+            old.via = children.steps[k];
+            old.parent = top.node;
+            old.g = g;
+            graph.positions[known * width] = child[0];
+            open.push({g + old.h, old.h, g, known});
+        }
+    }
+}
+
+void Solver::idaStar(const SolverOptions& options, SolveResult& result) const {
+    // Cheapest visit of each position in the current iteration, packed
+    // like a Graph
+    struct Visit {
+        unsigned int g;
+        unsigned int iteration;
+        uint16_t region;
+    };
+    Scratch scratch = newScratch();
+    std::vector<Visit> visits;
+    std::vector<uint16_t> visited;
+    NodeIndex index;
+    // Children of the position at each depth of the current path
+    std::deque<Children> levels;
+    Path path;
+    unsigned int bound = heuristic(start.data() + 1);
+    unsigned int iteration = 0, next = kInfinity;
+    bool aborted = false;
+
+    auto dfs = [&](auto& self, const uint16_t* position, unsigned int g,
+     std::size_t depth) -> bool {
+        unsigned int h = heuristic(position + 1);
+        if (h >= kInfinity) return false;
+        if (g + h > bound) {
+            next = std::min(next, g + h);
+            return false;
+        }
+        if (h == 0) return true;
+        if (result.nodesExpanded >= options.maxNodes) {
+            aborted = true;
+            return false;
+        }
+        uint16_t r = region(position, options.mode, scratch);
+        uint64_t key = hash(position, r);
+        uint32_t seen = index.find(key, [&](uint32_t v) {
+            return visits[v].region == r && std::equal(position + 1,
+                position + width, &visited[v * width + 1]);
+        });
+        if (seen == kNoParent) {
+            index.insert(key, static_cast<uint32_t>(visits.size()));
+            visits.push_back({g, iteration, r});
+            visited.insert(visited.end(), position, position + width);
+        } else {
+            Visit& visit = visits[seen];
+            if (visit.iteration == iteration && visit.g <= g) return false;
+            visit.g = g;
+            visit.iteration = iteration;
+        }
+        ++result.nodesExpanded;
+
+        if (levels.size() <= depth) levels.emplace_back();
+        Children& children = levels[depth];
+        expand(position, options.mode, scratch, children);
+        for (std::size_t k = 0; k < children.steps.size(); ++k) {
+            const uint16_t* child = &children.positions[k * width];
+            path.steps.push_back(children.steps[k]);
+            path.positions.insert(path.positions.end(), child, child + width);
+            if (self(self, child, g + 1, depth + 1)) return true;
+            path.steps.pop_back();
+            path.positions.resize(path.positions.size() - width);
+            if (aborted) return false;
+        }
+        return false;
+    };
+
+    while (bound < kInfinity) {
+        next = kInfinity;
+        if (dfs(dfs, start.data(), 0, 0)) {
+            finish(path, result, scratch);
+            return;
+        }
+        if (aborted) {
+            result.outOfBudget = true;
+            return;
+        }
+        bound = next;
+        ++iteration;
+    }
+}
+
+void Solver::expandPulls(const uint16_t* position, Scratch& scratch,
+ Children& out) const {
+    out.positions.clear();
+    out.steps.clear();
+    const uint16_t* boxes = position + 1;
+    occupy(position, scratch, 1);
+    floodFill(position[0], scratch);
+    // The player stands next to a box and steps away from it, dragging
+    // the box onto the square it left
+    for (std::size_t i = 0; i < boxCount(); ++i) {
+        uint16_t box = boxes[i];
+        for (int d = 0; d < 4; ++d) {
+            uint16_t at = static_cast<uint16_t>(box + offset[d]);
+            uint16_t to = static_cast<uint16_t>(at + offset[d]);
+            if (scratch.mark[at] != scratch.stamp || walls[to]
+             || scratch.occupied[to]) {
+                continue;
+            }
+            addChild(position, i, at, to, {box, static_cast<Direction>(d)},
+                out);
+        }
+    }
+    occupy(position, scratch, 0);
+}
+
+// Best-first search of one portfolio run, f = g + weight * h. Positions
+// are checked as they are generated rather than when expanded, since the
+// portfolio wants any answer soon, not the cheapest one.
+void Solver::search(Run& run, const SolverOptions& options) const {
+    struct Entry {
+        unsigned int f;
+        unsigned int h;
+        unsigned int g;
+        uint32_t node;
+    };
+    auto worse = [](const Entry& a, const Entry& b) {
+        return a.f != b.f ? a.f > b.f : a.h > b.h;
+    };
+    std::priority_queue<Entry, std::vector<Entry>, decltype(worse)> open(worse);
+    Graph& graph = run.graph;
+    graph.width = width;
+    Children children;
+    Scratch scratch = newScratch();
+
+    const int side = run.backward ? 1 : 0;
+    const uint16_t startRegion = region(start.data(), SolveMode::Pushes,
+        scratch);
+    // Finds a position among those of this side. Returns its node in this
+    // run, kTaken when another run holds it, or kNoParent when it is new
+    // and claimed for the next node. met is the other side's owner.
+    auto visit = [&](const uint16_t* position, uint16_t r, uint64_t key,
+     uint64_t& met) {
+        uint32_t next = static_cast<uint32_t>(graph.nodes.size());
+        SharedTable::Claim claim = run.shared->claim(key, side,
+            SharedTable::owner(run.id, next));
+        met = claim.other;
+        if (claim.placed && claim.owner == 0) return kNoParent;
+        if (claim.placed && claim.owner >> 32 != uint64_t(run.id) + 1) {
+            return kTaken;
+        }
+        if (claim.placed) {
+            uint32_t node = static_cast<uint32_t>(claim.owner);
+            if (graph.holds(node, position, r)) return node;
+        }
+        // No room in the table, or another of this run's positions under
+        // the same hash: the run indexes it by itself
+        met = 0;
+        uint32_t node = graph.find(position, r, key);
+        if (node == kNoParent) graph.index.insert(key, next);
+        return node;
+    };
+    // Claims the win for a new node that ends the search: the goal, the
+    // start for a backward run, or a position the other side has seen
+    auto ends = [&](const uint16_t* position, uint16_t r, uint32_t node,
+     uint64_t met) {
+        bool done = run.backward
+            ? r == startRegion && std::equal(position + 1, position + width,
+                start.begin() + 1)
+            : graph.nodes[node].h == 0;
+        if (!done && met == 0) return false;
+        int none = -1;
+        if (run.winner->compare_exchange_strong(none, run.id)) {
+            run.endNode = node;
+            if (!done) run.meeting = met;
+        }
+        return true;
+    };
+    auto add = [&](const uint16_t* position, uint16_t r, Step via,
+     uint32_t parent, unsigned int g, uint64_t met) {
+        unsigned int h = matchCost(position + 1, *run.targets);
+        uint32_t node = graph.push(position, r,
+            {parent, g, h, via, 0, h >= kInfinity});
+        if (h >= kInfinity) return false;
+        open.push({g + run.weight * h, h, g, node});
+        return ends(position, r, node, met);
+    };
+
+    // Going back, the player may start anywhere around the finished boxes
+    std::vector<uint16_t> roots(start);
+    if (run.backward) {
+        roots.clear();
+        std::vector<uint16_t> solved(1, 0);
+        solved.insert(solved.end(), goals.begin(), goals.end());
+        std::sort(solved.begin() + 1, solved.end());
+        std::vector<char> covered(walls.size(), 0);
+        occupy(solved.data(), scratch, 1);
+        for (std::size_t sq = 0; sq < walls.size(); ++sq) {
+            if (walls[sq] || scratch.occupied[sq] || covered[sq]) continue;
+            solved[0] = static_cast<uint16_t>(sq);
+            floodFill(solved[0], scratch);
+            for (uint16_t reached : scratch.queue) covered[reached] = 1;
+            roots.insert(roots.end(), solved.begin(), solved.end());
+        }
+        occupy(solved.data(), scratch, 0);
+    }
+    // Every run of a side starts from the same roots, so a root another
+    // run holds is still searched
+    for (std::size_t k = 0; k < roots.size(); k += width) {
+        const uint16_t* root = &roots[k];
+        uint16_t r = region(root, SolveMode::Pushes, scratch);
+        uint64_t met = 0;
+        uint32_t known = visit(root, r, hash(root, r), met);
+        if (known != kNoParent && known != kTaken) continue;
+        if (add(root, r, Step{0, Direction::Up}, kNoParent, 0, met)) return;
+    }
+
+    while (!open.empty()) {
+        if (run.winner->load(std::memory_order_relaxed) >= 0) return;
+        Entry top = open.top();
+        open.pop();
+        if (graph.nodes[top.node].closed || top.g != graph.nodes[top.node].g) {
+            continue;
+        }
+        if (run.expanded >= options.maxNodes) return;
+        graph.nodes[top.node].closed = true;
+        ++run.expanded;
+
+        if (run.backward) {
+            expandPulls(graph.at(top.node), scratch, children);
+        } else {
+            expand(graph.at(top.node), SolveMode::Pushes, scratch, children);
+        }
+        unsigned int g = top.g + 1;
+        for (std::size_t k = 0; k < children.steps.size(); ++k) {
+            const uint16_t* child = &children.positions[k * width];
+            uint16_t r = region(child, SolveMode::Pushes, scratch);
+            uint64_t met = 0;
+            uint32_t known = visit(child, r, hash(child, r), met);
+            if (known == kTaken) continue;
+            if (known == kNoParent) {
+                if (add(child, r, children.steps[k], top.node, g, met)) {
+                    return;
+                }
+                continue;
+            }
+            Graph::Node& old = graph.nodes[known];
+            if (old.closed || old.g <= g) continue;
+            old.via = children.steps[k];
+            old.parent = top.node;
+            old.g = g;
+            graph.positions[known * width] = child[0];
+            open.push({g + run.weight * old.h, old.h, g, known});
+        }
+    }
+    // Nothing left to try. Positions it skipped belong to the other runs
+    // of its side, so only when they have all run out too is it proof
+    // that the level cannot be solved.
+    run.exhausted = true;
+    if (run.left->fetch_sub(1) == 1) {
+        int none = -1;
+        run.winner->compare_exchange_strong(none, run.id);
+    }
+}
+
+void Solver::pathTo(const Run& run, uint32_t node, Path& path) const {
+    const Graph& graph = run.graph;
+    if (!run.backward) {
+        trace(graph, node, path);
+        return;
+    }
+    // Pulls from the node back to the finished boxes, each one undone as
+    // a push in the opposite direction
+    for (uint32_t n = node; graph.nodes[n].parent != kNoParent;
+     n = graph.nodes[n].parent) {
+        const Step& pull = graph.nodes[n].via;
+        const uint16_t* before = graph.at(graph.nodes[n].parent);
+        int d = static_cast<int>(pull.dir);
+        uint16_t at = static_cast<uint16_t>(pull.box + offset[d]);
+        path.steps.push_back({at, static_cast<Direction>(d ^ 1)});
+        std::size_t first = path.positions.size();
+        path.positions.insert(path.positions.end(), before, before + width);
+        path.positions[first] = at;
+    }
+}
+
+void Solver::portfolio(const SolverOptions& options,
+ SolveResult& result) const {
+    unsigned int threads = options.threads != 0 ? options.threads
+        : std::max(1u, std::thread::hardware_concurrency());
+    // Going back needs one finished position: every box on a goal
+    bool backward = threads > 1 && !goals.empty()
+        && boxCount() == goals.size();
+
+    // Pushes needed from each start square, by pushing boxes out of them
+    std::vector<std::vector<unsigned int>> toStart;
+    if (backward) {
+        toStart.assign(boxCount(),
+            std::vector<unsigned int>(walls.size(), kInfinity));
+        std::vector<uint16_t> queue;
+        for (std::size_t b = 0; b < boxCount(); ++b) {
+            std::vector<unsigned int>& dist = toStart[b];
+            queue.assign(1, start[b + 1]);
+            dist[start[b + 1]] = 0;
+            for (std::size_t head = 0; head < queue.size(); ++head) {
+                uint16_t box = queue[head];
+                for (int d : offset) {
+                    int to = box + d, player = box - d;
+                    if (to < 0 || to >= static_cast<int>(walls.size())
+                     || player < 0 || walls[to] || walls[player]
+                     || dist[to] != kInfinity) {
+                        continue;
+                    }
+                    dist[to] = dist[box] + 1;
+                    queue.push_back(static_cast<uint16_t>(to));
+                }
+            }
+        }
+    }
+
+    SharedTable shared(options.sharedPositions != 0 ? options.sharedPositions
+        : options.maxNodes * threads);
+    std::atomic<int> winner{-1};
+    std::atomic<int> left[2] = {0, 0};
+    std::vector<std::unique_ptr<Run>> runs;
+    for (unsigned int i = 0; i < threads; ++i) {
+        auto run = std::make_unique<Run>();
+        run->id = static_cast<int>(i);
+        run->backward = backward && i % 2 == 1;
+        unsigned int level = backward ? i / 2 : i;
+        run->weight = 1 + 2 * level;
+        run->name = run->backward ? "backward" : "forward";
+        if (run->weight > 1) run->name += " x" + std::to_string(run->weight);
+        run->targets = run->backward ? &toStart : &distance;
+        run->shared = &shared;
+        run->winner = &winner;
+        run->left = &left[run->backward ? 1 : 0];
+        ++*run->left;
+        runs.push_back(std::move(run));
+    }
+    std::vector<std::thread> workers;
+    for (const std::unique_ptr<Run>& run : runs) {
+        Run* r = run.get();
+        workers.emplace_back([this, r, &options, &winner] {
+            try {
+                search(*r, options);
+            } catch (...) {
+                r->failure = std::current_exception();
+                int none = -1;
+                winner.compare_exchange_strong(none, r->id);
+            }
+        });
+    }
+    for (std::thread& worker : workers) worker.join();
+
+    for (const std::unique_ptr<Run>& run : runs) {
+        result.nodesExpanded += run->expanded;
+    }
+    int w = winner.load();
+    if (w < 0) {
+        result.outOfBudget = true;
+        return;
+    }
+    const Run& won = *runs[w];
+    if (won.failure) std::rethrow_exception(won.failure);
+    if (won.exhausted) return;  // proven unsolvable
+
+    Path path;
+    result.strategy = won.name;
+    if (won.meeting == 0) {
+        pathTo(won, won.endNode, path);
+    } else {
+        const Run* partner = runs[(won.meeting >> 32) - 1].get();
+        uint32_t partnerNode = static_cast<uint32_t>(won.meeting);
+        // The table only compared hashes
+        if (partnerNode >= partner->graph.nodes.size()
+         || !partner->graph.holds(partnerNode, won.graph.at(won.endNode),
+            won.graph.nodes[won.endNode].region)) {
+            result.outOfBudget = true;  // a hash collision, not a meeting
+            return;
+        }
+        const Run& front = won.backward ? *partner : won;
+        const Run& back = won.backward ? won : *partner;
+        pathTo(front, won.backward ? partnerNode : won.endNode, path);
+        pathTo(back, won.backward ? won.endNode : partnerNode, path);
+        result.strategy = front.name + " met " + back.name;
+    }
+    Scratch scratch = newScratch();
+    finish(path, result, scratch);
+}
+
+}  // namespace SB
@@ -0,0 +1,155 @@
+//  Copyright 2025 <Orbosa Igbinovia> [legal/copyright]
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Deadlock.hpp"
+#include "GameState.hpp"
+#include "Zobrist.hpp"
+
+namespace SB {
+
+//  What the solver minimises
+enum class SolveMode {
+    Pushes, Moves
+};
+
+//  Portfolio runs several searches on their own threads, see
+//  Solver::solve
+enum class SearchAlgorithm {
+    AStar, IDAStar, Portfolio
+};
+
+struct SolverOptions {
+    SolveMode mode = SolveMode::Pushes;
+    SearchAlgorithm algorithm = SearchAlgorithm::AStar;
+    std::size_t maxNodes = 2000000;  //  give up after this many expansions
+    //  Portfolio searches run at once, 0 for one per hardware thread
+    unsigned int threads = 0;
+    //  Positions the portfolio's shared table is sized for, 0 for maxNodes
+    //  per search
+    std::size_t sharedPositions = 0;
+};
+
+struct SolveResult {
+    bool solved = false;
+    std::vector<Direction> moves;  //  every player step, pushes included
+    unsigned int pushes = 0;
+    std::size_t nodesExpanded = 0;
+    //  Stopped at maxNodes. When false and not solved, the search ran out
+    //  of positions and the level is proven unsolvable.
+    bool outOfBudget = false;
+    double seconds = 0.0;
+    double nodesPerSecond = 0.0;
+    //  Portfolio: the search that found the answer
+    std::string strategy;
+};
+
+//  Search from the current position of a game. The board is copied once
+//  into a padded grid, so solving never touches the game again.
+class Solver {
+ public:
+    explicit Solver(const GameState& level);
+    //  Portfolio always minimises pushes but does not promise the fewest.
+    //  Its searches are forward pushes from the start and backward pulls
+    //  from the boxes on their goals (when there are as many boxes as
+    //  goals), at rising heuristic weights. Each claims the positions it
+    //  reaches in one lock-free table and skips those another search of
+    //  its side holds; a forward search reaching a position the backward
+    //  side has seen joins the two paths. The first answer stops every
+    //  search. maxNodes applies per search.
+    SolveResult solve(const SolverOptions& options = SolverOptions()) const;
+    //  Squares from which no box can ever reach a goal
+    bool isDeadSquare(unsigned int x, unsigned int y) const;
+    //  Minimum-cost box to goal matching for the starting position
+    unsigned int lowerBound() const;
+
+ private:
+    //  A position is packed into width squares: the player, then the
+    //  boxes in ascending order. A search keeps its positions back to
+    //  back in one vector, so a node owns no allocation, and finds them
+    //  again by Zobrist hash.
+    //
+    //  One edge of the search graph
+    struct Step {
+        uint16_t box;  //  square of the pushed box, or 0 for a plain step
+        Direction dir;
+    };
+    //  Children of one expansion, child i packed at [i * width]
+    struct Children {
+        std::vector<uint16_t> positions;
+        std::vector<Step> steps;
+    };
+    //  Steps from the start, with the position after each packed alike
+    struct Path {
+        std::vector<Step> steps;
+        std::vector<uint16_t> positions;
+    };
+    //  Nodes of one best-first search (defined in Solver.cpp)
+    struct Graph;
+    //  One search of the portfolio (defined in Solver.cpp)
+    struct Run;
+    //  Buffers reused by every expansion so the search does not allocate
+    struct Scratch {
+        std::vector<char> occupied;
+        std::vector<uint32_t> mark;
+        std::vector<uint16_t> queue;
+        std::vector<uint16_t> parent;
+        uint32_t stamp = 0;
+        Deadlock::Scratch corral;
+    };
+
+    unsigned int stride;  //  board width plus the wall border
+    std::vector<char> walls;
+    Deadlock deadlocks;
+    Zobrist zobrist;
+    std::vector<uint16_t> goals;
+    std::vector<std::vector<unsigned int>> distance;  //  [goal][square]
+    std::size_t width = 1;  //  squares per packed position
+    std::vector<uint16_t> start;  //  packed
+    int offset[4];
+
+    std::size_t boxCount() const { return width - 1; }
+    uint16_t square(unsigned int x, unsigned int y) const;
+    void computeDistances();
+    Scratch newScratch() const;
+    unsigned int heuristic(const uint16_t* boxes) const;
+    //  Cheapest matching of boxes to the rows of a distance table
+    unsigned int matchCost(const uint16_t* boxes,
+        const std::vector<std::vector<unsigned int>>& table) const;
+    void occupy(const uint16_t* position, Scratch& scratch, char value) const;
+    void floodFill(uint16_t player, Scratch& scratch) const;
+    //  The square that stands for the player's position in the hash: the
+    //  lowest one it can walk to when pushes are counted, else its own
+    uint16_t region(const uint16_t* position, SolveMode mode,
+        Scratch& scratch) const;
+    uint64_t hash(const uint16_t* position, uint16_t region) const;
+    //  Pushing the box on from onto to loses the level
+    bool losesLevel(uint16_t from, uint16_t to, Scratch& scratch) const;
+    //  Appends position with box i moved to a new square and the player
+    //  on player, keeping the boxes sorted
+    void addChild(const uint16_t* position, std::size_t i, uint16_t to,
+        uint16_t player, Step step, Children& out) const;
+    void expand(const uint16_t* position, SolveMode mode, Scratch& scratch,
+        Children& out) const;
+    //  Player steps to target, without pushing. False when it cannot get
+    //  there.
+    bool walk(const uint16_t* position, uint16_t target, Scratch& scratch,
+        std::vector<Direction>& steps) const;
+    void finish(const Path& path, SolveResult& result, Scratch& scratch)
+        const;
+    //  Steps from the first node of graph to node
+    void trace(const Graph& graph, uint32_t node, Path& path) const;
+    void aStar(const SolverOptions& options, SolveResult& result) const;
+    void idaStar(const SolverOptions& options, SolveResult& result) const;
+    //  Pull moves of the backward search; Step::box is the square the box
+    //  was pulled from
+    void expandPulls(const uint16_t* position, Scratch& scratch,
+        Children& out) const;
+    void portfolio(const SolverOptions& options, SolveResult& result) const;
+    void search(Run& run, const SolverOptions& options) const;
+    //  Forward steps from the start to the run's node
+    void pathTo(const Run& run, uint32_t node, Path& path) const;
+};
+
+}  // namespace SB
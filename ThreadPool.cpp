@@ -0,0 +1,124 @@
+//  Copyright 2025 <Orbosa Igbinovia> [legal/copyright]
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <utility>
+
+namespace SB {
+
+namespace {
+// Which pool and deque the current thread works for
+thread_local const ThreadPool* currentPool = nullptr;
+thread_local unsigned int currentQueue = 0;
+}  // namespace
+
+ThreadPool::ThreadPool(unsigned int threads) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for (unsigned int i = 0; i < threads; ++i) {
+        queues.push_back(std::make_unique<Queue>());
+    }
+    for (unsigned int i = 0; i < threads; ++i) {
+        workers.emplace_back(&ThreadPool::run, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::unique_lock<std::mutex> guard(idleLock);
+        finished.wait(guard, [this] { return pending == 0; });
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+// The queues are all in place before any worker starts, unlike workers
+unsigned int ThreadPool::size() const {
+    return static_cast<unsigned int>(queues.size());
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+    // Workers keep what they spawn, outside callers spread round robin
+    unsigned int target = currentPool == this ? currentQueue
+        : nextQueue++ % size();
+    {
+        std::lock_guard<std::mutex> guard(idleLock);
+        ++pending;
+    }
+    {
+        std::lock_guard<std::mutex> guard(queues[target]->lock);
+        queues[target]->tasks.push_back(std::move(task));
+    }
+    ++queued;
+    {
+        // Taking the lock orders this with a worker about to sleep
+        std::lock_guard<std::mutex> guard(idleLock);
+    }
+    wake.notify_one();
+}
+
+void ThreadPool::wait() {
+    std::unique_lock<std::mutex> guard(idleLock);
+    finished.wait(guard, [this] { return pending == 0; });
+    if (failure) {
+        std::exception_ptr error = std::exchange(failure, nullptr);
+        guard.unlock();
+        std::rethrow_exception(error);
+    }
+}
+
+// Own deque from the back, then the front of everyone else's
+bool ThreadPool::take(unsigned int self, std::function<void()>& task) {
+    {
+        Queue& own = *queues[self];
+        std::lock_guard<std::mutex> guard(own.lock);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+    for (unsigned int i = 1; i < size(); ++i) {
+        Queue& victim = *queues[(self + i) % size()];
+        std::lock_guard<std::mutex> guard(victim.lock);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::run(unsigned int self) {
+    currentPool = this;
+    currentQueue = self;
+    std::function<void()> task;
+    for (;;) {
+        if (take(self, task)) {
+            --queued;
+            try {
+                task();
+            } catch (...) {
+                std::lock_guard<std::mutex> guard(idleLock);
+                if (!failure) failure = std::current_exception();
+            }
+            task = nullptr;
+            std::lock_guard<std::mutex> guard(idleLock);
+            if (--pending == 0) {
+                finished.notify_all();
+            }
+            continue;
+        }
+        std::unique_lock<std::mutex> guard(idleLock);
+        wake.wait(guard, [this] { return stopping || queued > 0; });
+        if (stopping && queued == 0) {
+            return;
+        }
+    }
+}
+
+}  // namespace SB
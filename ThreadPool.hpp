@@ -0,0 +1,56 @@
+//  Copyright 2025 <Orbosa Igbinovia> [legal/copyright]
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace SB {
+
+//  Fixed set of worker threads, each with its own task deque. A worker
+//  takes its newest task first and, when it runs dry, steals the oldest
+//  task of another worker, so uneven jobs (one hard level among many easy
+//  ones) keep every core busy. Tasks may submit more tasks; those land on
+//  the submitting worker's own deque.
+class ThreadPool {
+ public:
+    //  0 threads means one per hardware thread
+    explicit ThreadPool(unsigned int threads = 0);
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void submit(std::function<void()> task);
+    //  Blocks until every task, including ones submitted by tasks, has run.
+    //  Rethrows the first exception a task threw. Not for use inside a task.
+    void wait();
+    unsigned int size() const;
+
+ private:
+    struct Queue {
+        std::mutex lock;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+    std::mutex idleLock;
+    std::condition_variable wake;
+    std::condition_variable finished;
+    std::atomic<std::size_t> queued{0};  //  sitting in some deque
+    std::size_t pending = 0;  //  submitted and not finished, under idleLock
+    std::atomic<unsigned int> nextQueue{0};
+    std::exception_ptr failure;
+    bool stopping = false;
+
+    bool take(unsigned int self, std::function<void()>& task);
+    void run(unsigned int self);
+};
+
+}  // namespace SB
@@ -0,0 +1,331 @@
+//  Copyright 2025 <Orbosa Igbinovia> [legal/copyright]
+#include "Verifier.hpp"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include "GameState.hpp"
+#include "LevelPack.hpp"
+#include "LevelParser.hpp"
+#include "Replay.hpp"
+#include "ThreadPool.hpp"
+
+namespace SB {
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+double since(Clock::time_point begin) {
+    return std::chrono::duration<double>(Clock::now() - begin).count();
+}
+
+// Files to check, directories expanded in name order
+std::vector<std::string> listInputs(const std::vector<std::string>& inputs) {
+    namespace fs = std::filesystem;
+    std::vector<std::string> files;
+    for (const std::string& input : inputs) {
+        if (!fs::is_directory(input)) {
+            files.push_back(input);
+            continue;
+        }
+        std::vector<std::string> found;
+        for (const fs::directory_entry& entry : fs::directory_iterator(input)) {
+            std::string ext = entry.path().extension().string();
+            if (entry.is_regular_file() && (ext == ".lvl" || ext == ".xsb"
+             || ext == ".sbpk" || LevelPack::isPack(entry.path().string()))) {
+                found.push_back(entry.path().string());
+            }
+        }
+        std::sort(found.begin(), found.end());
+        files.insert(files.end(), found.begin(), found.end());
+    }
+    return files;
+}
+
+// True when the player can walk onto the outermost ring of the level,
+// i.e. only the padding outside the file keeps it on the board
+bool openEdge(const GameState& game) {
+    const Board& board = game.board();
+    std::vector<uint8_t> seen(board.size(), 0);
+    std::vector<std::size_t> queue(1, game.player());
+    seen[game.player()] = 1;
+    for (std::size_t head = 0; head < queue.size(); ++head) {
+        std::size_t sq = queue[head];
+        unsigned int x = board.column(sq), y = board.row(sq);
+        if (x == 0 || y == 0 || x + 1 == board.width()
+         || y + 1 == board.height()) {
+            return true;
+        }
+        for (Direction dir : {Direction::Up, Direction::Down,
+         Direction::Left, Direction::Right}) {
+            std::size_t next = sq + board.step(dir);
+            // Boxes can be pushed out of the way, only walls enclose
+            if (!seen[next] && !board.isWall(next)) {
+                seen[next] = 1;
+                queue.push_back(next);
+            }
+        }
+    }
+    return false;
+}
+
+void writeString(std::ostream& out, const std::string& text) {
+    out << '"';
+    for (char c : text) {
+        switch (c) {
+            case '"': out << "\\\""; break;
+            case '\\': out << "\\\\"; break;
+            case '\n': out << "\\n"; break;
+            case '\t': out << "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    const char* hex = "0123456789abcdef";
+                    out << "\\u00" << hex[(c >> 4) & 0xF] << hex[c & 0xF];
+                } else {
+                    out << c;
+                }
+        }
+    }
+    out << '"';
+}
+}  // namespace
+
+const char* statusName(LevelReport::Status status) {
+    switch (status) {
+        case LevelReport::Solved: return "solved";
+        case LevelReport::Unsolvable: return "unsolvable";
+        case LevelReport::OutOfBudget: return "out_of_budget";
+        case LevelReport::Invalid: return "invalid";
+    }
+    return "invalid";
+}
+
+std::size_t VerifyReport::count(LevelReport::Status status) const {
+    return std::count_if(levels.begin(), levels.end(),
+        [status](const LevelReport& level) {
+            return level.status == status;
+        });
+}
+
+std::size_t VerifyReport::cached() const {
+    return std::count_if(levels.begin(), levels.end(),
+        [](const LevelReport& level) { return level.cached; });
+}
+
+LevelReport verifyLevel(const Board& level, const SolverOptions& options,
+ SolutionCache* cache) {
+    LevelReport report;
+    report.width = level.width();
+    report.height = level.height();
+    GameState game(level);
+    if (!game.isLoaded()) {
+        report.error = "level has no player";
+        return report;
+    }
+
+    if (game.boxes().size() != game.goalCount()) {
+        report.warnings.push_back(std::to_string(game.boxes().size())
+            + " boxes but " + std::to_string(game.goalCount()) + " goals");
+    }
+    if (openEdge(game)) {
+        report.warnings.push_back("player can reach the edge of the level");
+    }
+    if (game.isWon()) {
+        report.warnings.push_back("already won at the start");
+    }
+    if (game.isDeadlocked()) {
+        report.warnings.push_back("deadlocked at the start");
+        report.status = LevelReport::Unsolvable;
+        return report;
+    }
+
+    try {
+        uint64_t key = cache ? levelKey(level) : 0;
+        std::optional<CacheEntry> known;
+        if (cache) {
+            known = cache->find(key);
+        }
+        if (known && (known->status == CacheEntry::Solved
+         || known->status == CacheEntry::Unsolvable
+         || (known->status == CacheEntry::OutOfBudget
+            && known->budget >= options.maxNodes))) {
+            report.cached = true;
+            report.moves = known->moves;
+            report.pushes = known->pushes;
+            report.nodes = known->nodes;
+            report.solveSeconds = known->solveSeconds;
+            report.status = known->status == CacheEntry::Solved
+                ? LevelReport::Solved : known->status == CacheEntry::Unsolvable
+                ? LevelReport::Unsolvable : LevelReport::OutOfBudget;
+            return report;
+        }
+
+        SolveResult result = Solver(game).solve(options);
+        report.moves = result.moves.size();
+        report.pushes = result.pushes;
+        report.nodes = result.nodesExpanded;
+        report.solveSeconds = result.seconds;
+        report.status = result.solved ? LevelReport::Solved
+            : result.outOfBudget ? LevelReport::OutOfBudget
+            : LevelReport::Unsolvable;
+        if (cache) {
+            CacheEntry entry;
+            entry.key = key;
+            entry.status = result.solved ? CacheEntry::Solved
+                : result.outOfBudget ? CacheEntry::OutOfBudget
+                : CacheEntry::Unsolvable;
+            entry.nodes = result.nodesExpanded;
+            entry.budget = options.maxNodes;
+            entry.solveSeconds = result.seconds;
+            if (result.solved) {
+                GameState played = game;
+                played.moveAll(result.moves);
+                entry.solution = toLurd(played);
+            }
+            cache->record(level, entry);
+        }
+    } catch (const std::exception& e) {
+        report.error = e.what();
+        report.status = LevelReport::Invalid;
+    }
+    return report;
+}
+
+VerifyReport verify(const std::vector<std::string>& inputs,
+ const VerifyOptions& options) {
+    VerifyReport report;
+    Clock::time_point begin = Clock::now();
+    std::mutex lock;
+    auto record = [&](LevelReport level) {
+        std::lock_guard<std::mutex> guard(lock);
+        report.levels.push_back(std::move(level));
+    };
+    auto invalid = [&](const std::string& source, std::size_t index,
+     const std::string& error) {
+        LevelReport level;
+        level.source = source;
+        level.index = index;
+        level.error = error;
+        record(std::move(level));
+    };
+
+    ThreadPool pool(options.threads);
+    report.threads = pool.size();
+    // One task per file, which fans out into one task per level. Workers
+    // keep the levels they spawn and idle workers steal them.
+    for (const std::string& file : listInputs(inputs)) {
+        pool.submit([&, file] {
+            Clock::time_point start = Clock::now();
+            if (LevelPack::isPack(file)) {
+                std::shared_ptr<LevelPack> pack;
+                try {
+                    pack = std::make_shared<LevelPack>(file);
+                } catch (const std::exception& e) {
+                    invalid(file, 0, e.what());
+                    return;
+                }
+                for (std::size_t i = 0; i < pack->size(); ++i) {
+                    pool.submit([&, file, pack, i] {
+                        Clock::time_point decode = Clock::now();
+                        try {
+                            Board level = pack->level(i);
+                            double parse = since(decode);
+                            LevelReport result = verifyLevel(level,
+                                options.solver, options.cache);
+                            result.source = file;
+                            result.index = i;
+                            result.parseSeconds = parse;
+                            record(std::move(result));
+                        } catch (const std::exception& e) {
+                            invalid(file, i, e.what());
+                        }
+                    });
+                }
+                return;
+            }
+
+            ParseResult parsed;
+            try {
+                parsed = readLevels(file);
+            } catch (const std::exception& e) {
+                invalid(file, 0, e.what());
+                return;
+            }
+            double parse = since(start);
+            if (!parsed.ok()) {
+                invalid(file, parsed.levels.size(),
+                    LevelError(*parsed.error).what());
+            }
+            auto levels = std::make_shared<std::vector<Board>>(
+                std::move(parsed.levels));
+            for (std::size_t i = 0; i < levels->size(); ++i) {
+                pool.submit([&, file, levels, i, parse] {
+                    try {
+                        LevelReport result = verifyLevel((*levels)[i],
+                            options.solver, options.cache);
+                        result.source = file;
+                        result.index = i;
+                        result.parseSeconds = parse;
+                        record(std::move(result));
+                    } catch (const std::exception& e) {
+                        invalid(file, i, e.what());
+                    }
+                });
+            }
+        });
+    }
+    pool.wait();
+
+    std::sort(report.levels.begin(), report.levels.end(),
+        [](const LevelReport& a, const LevelReport& b) {
+            return a.source != b.source ? a.source < b.source
+                : a.index < b.index;
+        });
+    report.seconds = since(begin);
+    return report;
+}
+
+void writeJson(std::ostream& out, const VerifyReport& report) {
+    out << "{\n  \"threads\": " << report.threads
+        << ",\n  \"seconds\": " << report.seconds
+        << ",\n  \"summary\": {";
+    const LevelReport::Status all[] = {LevelReport::Solved,
+        LevelReport::Unsolvable, LevelReport::OutOfBudget,
+        LevelReport::Invalid};
+    for (LevelReport::Status status : all) {
+        out << (status == LevelReport::Solved ? "" : ", ") << '"'
+            << statusName(status) << "\": " << report.count(status);
+    }
+    out << ", \"cached\": " << report.cached();
+    out << "},\n  \"levels\": [";
+    for (std::size_t i = 0; i < report.levels.size(); ++i) {
+        const LevelReport& level = report.levels[i];
+        out << (i == 0 ? "\n" : ",\n") << "    {\"source\": ";
+        writeString(out, level.source);
+        out << ", \"index\": " << level.index
+            << ", \"status\": \"" << statusName(level.status) << '"'
+            << ", \"width\": " << level.width
+            << ", \"height\": " << level.height
+            << ", \"moves\": " << level.moves
+            << ", \"pushes\": " << level.pushes
+            << ", \"nodes\": " << level.nodes
+            << ", \"parseSeconds\": " << level.parseSeconds
+            << ", \"solveSeconds\": " << level.solveSeconds
+            << ", \"cached\": " << (level.cached ? "true" : "false");
+        if (!level.error.empty()) {
+            out << ", \"error\": ";
+            writeString(out, level.error);
+        }
+        out << ", \"warnings\": [";
+        for (std::size_t w = 0; w < level.warnings.size(); ++w) {
+            out << (w == 0 ? "" : ", ");
+            writeString(out, level.warnings[w]);
+        }
+        out << "]}";
+    }
+    out << "\n  ]\n}\n";
+}
+
+}  // namespace SB
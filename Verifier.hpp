@@ -0,0 +1,63 @@
+//  Copyright 2025 <Orbosa Igbinovia> [legal/copyright]
+#pragma once
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "Board.hpp"
+#include "SolutionCache.hpp"
+#include "Solver.hpp"
+
+namespace SB {
+
+struct VerifyOptions {
+    unsigned int threads = 0;  //  0 for one per hardware thread
+    SolverOptions solver;  //  maxNodes is the search budget per level
+    //  Levels the cache already settled are not solved again, and new
+    //  results are added to it. Not owned, may be null.
+    SolutionCache* cache = nullptr;
+};
+
+//  Outcome of checking one level
+struct LevelReport {
+    enum Status { Solved, Unsolvable, OutOfBudget, Invalid };
+
+    std::string source;  //  file the level came from
+    std::size_t index = 0;  //  position of the level in that file
+    Status status = Invalid;
+    std::string error;  //  why an Invalid level was rejected
+    std::vector<std::string> warnings;  //  legal but suspicious
+    unsigned int width = 0;
+    unsigned int height = 0;
+    std::size_t moves = 0;
+    unsigned int pushes = 0;
+    std::size_t nodes = 0;
+    double parseSeconds = 0.0;  //  shared by every level of a text file
+    double solveSeconds = 0.0;
+    bool cached = false;  //  solve result taken from the cache
+};
+
+struct VerifyReport {
+    std::vector<LevelReport> levels;  //  sorted by source, then index
+    unsigned int threads = 0;
+    double seconds = 0.0;  //  wall clock for the whole run
+    std::size_t count(LevelReport::Status status) const;
+    std::size_t cached() const;
+};
+
+//  Structural checks and a bounded solve of a single level. With a cache,
+//  a level proven solvable or unsolvable before, or out of a budget at
+//  least as big, skips the solve.
+LevelReport verifyLevel(const Board& level, const SolverOptions& options,
+    SolutionCache* cache = nullptr);
+
+//  Checks every level of every input in parallel. Inputs are .lvl/.xsb
+//  text files, level packs, or directories holding any of them.
+VerifyReport verify(const std::vector<std::string>& inputs,
+    const VerifyOptions& options = VerifyOptions());
+
+void writeJson(std::ostream& out, const VerifyReport& report);
+
+const char* statusName(LevelReport::Status status);
+
+}  // namespace SB
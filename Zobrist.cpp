@@ -0,0 +1,22 @@
+//  Copyright 2025 <Orbosa Igbinovia> [legal/copyright]
+#include "Zobrist.hpp"
+
+namespace SB {
+
+namespace {
+// splitmix64, a well mixed 64-bit value for each counter
+uint64_t mix(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+}  // namespace
+
+Zobrist::Zobrist(std::size_t squares) : keys(2 * squares) {
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        keys[i] = mix(i);
+    }
+}
+
+}  // namespace SB
@@ -0,0 +1,26 @@
+//  Copyright 2025 <Orbosa Igbinovia> [legal/copyright]
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace SB {
+
+//  Random 64-bit key for "a box on square i" and "the player on square i".
+//  A position's hash is the XOR of its keys, so a move updates it with two
+//  or four XORs. Keys depend only on the square index, never on a random
+//  device, so hashes match across runs and machines.
+class Zobrist {
+ public:
+    explicit Zobrist(std::size_t squares);
+
+    uint64_t box(std::size_t square) const { return keys[2 * square]; }
+    uint64_t player(std::size_t square) const {
+        return keys[2 * square + 1];
+    }
+
+ private:
+    std::vector<uint64_t> keys;
+};
+
+}  // namespace SB
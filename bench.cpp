@@ -0,0 +1,281 @@
+//  Copyright 2025 <Orbosa Igbinovia> [legal/copyright]
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "BatchSim.hpp"
+#include "FixedBoard.hpp"
+#include "Sokoban.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+//  Results the compiler must not throw away
+volatile std::size_t sink = 0;
+
+struct BenchResult {
+    std::string name;
+    unsigned int size;
+    std::size_t boxes;
+    std::size_t ops;
+    double nsPerOp;  //  median over the repeats
+};
+
+// Open square room in the course format. The player starts in the top
+// left corner with a clear lane to the right for walking, and one box on
+// the row below with room to push it to the far wall. Every other box
+// and all goals are scattered below with a fixed seed, so runs compare.
+std::string levelText(unsigned int size, std::size_t boxes) {
+    std::vector<std::string> rows(size, std::string(size, '.'));
+    for (unsigned int i = 0; i < size; ++i) {
+        rows[0][i] = rows[size - 1][i] = '#';
+        rows[i][0] = rows[i][size - 1] = '#';
+    }
+    rows[1][1] = '@';
+    rows[2][2] = 'A';
+
+    std::vector<std::size_t> free;
+    for (unsigned int y = 4; y + 1 < size; ++y) {
+        for (unsigned int x = 2; x + 2 < size; ++x) {
+            free.push_back(y * size + x);
+        }
+    }
+    std::mt19937 rng(42);
+    std::shuffle(free.begin(), free.end(), rng);
+    boxes = std::min(boxes, free.size() / 2 + 1);
+    for (std::size_t i = 0; i < boxes; ++i) {
+        std::size_t goal = free[2 * i];
+        rows[goal / size][goal % size] = 'a';
+        if (i > 0) {
+            std::size_t box = free[2 * i + 1];
+            rows[box / size][box % size] = 'A';
+        }
+    }
+
+    std::string text = std::to_string(size) + " " + std::to_string(size)
+        + "\n";
+    for (const std::string& row : rows) {
+        text += row + "\n";
+    }
+    return text;
+}
+
+// Times repeats runs of body(ops) and returns the median ns per op.
+// body returns the seconds it wants counted, so untimed setup can be
+// left out of the measurement.
+template <class Body>
+double median(std::size_t repeats, std::size_t ops, Body body) {
+    std::vector<double> samples;
+    for (std::size_t r = 0; r < repeats; ++r) {
+        samples.push_back(body(ops) * 1e9 / static_cast<double>(ops));
+    }
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2];
+}
+
+double since(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+void writeJson(std::ostream& out, const std::vector<BenchResult>& results,
+ std::size_t repeats) {
+    out << "{\n  \"repeats\": " << repeats << ",\n  \"benchmarks\": [";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const BenchResult& r = results[i];
+        out << (i == 0 ? "\n" : ",\n") << "    {\"name\": \"" << r.name
+            << "\", \"size\": " << r.size << ", \"boxes\": " << r.boxes
+            << ", \"ops\": " << r.ops << ", \"nsPerOp\": " << r.nsPerOp
+            << ", \"opsPerSecond\": "
+            << (r.nsPerOp > 0 ? 1e9 / r.nsPerOp : 0) << "}";
+    }
+    out << "\n  ]\n}\n";
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    std::vector<unsigned int> sizes = {10, 32, 100, 316, 1000};
+    std::size_t repeats = 5;
+    std::string outFile;
+    for (int i = 1; i < argc; ++i) {
+        std::string flag = argv[i];
+        if (flag == "--quick") {
+            sizes = {10, 100};
+        } else if (flag == "--repeats" && i + 1 < argc) {
+            repeats = std::max<std::size_t>(1,
+                std::strtoul(argv[++i], nullptr, 10));
+        } else if (flag == "--out" && i + 1 < argc) {
+            outFile = argv[++i];
+        } else {
+            std::cerr << "Usage: ./sokoban-bench [--quick] [--repeats N] "
+             "[--out results.json]\n";
+            return 1;
+        }
+    }
+
+    std::vector<BenchResult> results;
+    sf::RenderTexture canvas;
+    canvas.create(1024, 1024);
+    for (unsigned int size : sizes) {
+        std::size_t area = static_cast<std::size_t>(size) * size;
+        for (std::size_t boxes : {std::size_t{1}, area / 50}) {
+            if (boxes == 0) continue;
+            std::string text = levelText(size, boxes);
+            SB::Sokoban game;
+            std::istringstream level(text);
+            level >> game;
+            boxes = game.getBoxes().size();
+            auto record = [&](const std::string& name, std::size_t ops,
+             double ns) {
+                results.push_back({name, size, boxes, ops, ns});
+                std::cerr << name << " " << size << "x" << size << " "
+                 << boxes << " boxes: " << ns << " ns/op\n";
+            };
+
+            // Walks back and forth along the empty top row
+            const std::size_t steps = 200000;
+            record("move_walk", steps, median(repeats, steps,
+             [&](std::size_t ops) {
+                game.reset();
+                auto start = Clock::now();
+                for (std::size_t i = 0; i < ops; ++i) {
+                    game.movePlayer(i % 2 ? SB::Direction::Left
+                        : SB::Direction::Right);
+                }
+                return since(start);
+            }));
+
+            // The same walk for a batch of 256 instances in one call per
+            // step, counted per instance step
+            const std::size_t lanes = 256;
+            SB::BatchSim batch(game.getBoard(), lanes);
+            record("batch_walk", steps, median(repeats, steps,
+             [&](std::size_t ops) {
+                batch.reset();
+                std::size_t moved = 0;
+                auto start = Clock::now();
+                for (std::size_t i = 0; i < ops / lanes; ++i) {
+                    moved += batch.step(i % 2 ? SB::Direction::Left
+                        : SB::Direction::Right);
+                }
+                double seconds = since(start);
+                sink = sink + moved;
+                return seconds;
+            }));
+
+            // The same walk on the compiled-in 16 x 16 kernel
+            if (SB::FixedBoard<16, 16>::fits(game.getBoard())) {
+                const SB::FixedBoard<16, 16> fixed(game.getBoard());
+                record("fixed_walk", steps, median(repeats, steps,
+                 [&](std::size_t ops) {
+                    SB::FixedBoard<16, 16> board = fixed;
+                    std::size_t moved = 0;
+                    auto start = Clock::now();
+                    for (std::size_t i = 0; i < ops; ++i) {
+                        moved += board.move(i % 2 ? SB::Direction::Left
+                            : SB::Direction::Right);
+                    }
+                    double seconds = since(start);
+                    sink = sink + moved;
+                    return seconds;
+                }));
+            }
+
+            // Takes all those steps back again
+            record("undo", steps, median(repeats, steps,
+             [&](std::size_t ops) {
+                game.reset();
+                for (std::size_t i = 0; i < ops; ++i) {
+                    game.movePlayer(i % 2 ? SB::Direction::Left
+                        : SB::Direction::Right);
+                }
+                auto start = Clock::now();
+                for (std::size_t i = 0; i < ops; ++i) {
+                    game.undo();
+                }
+                return since(start);
+            }));
+
+            // Pushes the lane box to the far wall, rewinding between runs
+            const std::size_t lane = size - 4;
+            const std::size_t pushes = lane * std::max<std::size_t>(1,
+                steps / lane / 4);
+            record("move_push", pushes, median(repeats, pushes,
+             [&](std::size_t ops) {
+                double seconds = 0;
+                for (std::size_t done = 0; done < ops; done += lane) {
+                    game.reset();
+                    game.movePlayer(SB::Direction::Down);
+                    auto start = Clock::now();
+                    for (std::size_t i = 0; i < lane; ++i) {
+                        game.movePlayer(SB::Direction::Right);
+                    }
+                    seconds += since(start);
+                }
+                return seconds;
+            }));
+
+            const std::size_t checks = 1000000;
+            record("is_won", checks, median(repeats, checks,
+             [&](std::size_t ops) {
+                std::size_t won = 0;
+                auto start = Clock::now();
+                for (std::size_t i = 0; i < ops; ++i) {
+                    won += game.isWon();
+                }
+                double seconds = since(start);
+                sink = sink + won;
+                return seconds;
+            }));
+
+            // Whole-board work, fewer repetitions on the bigger boards
+            const std::size_t boardOps = std::max<std::size_t>(3,
+                1000000 / area);
+            record("parse", boardOps, median(repeats, boardOps,
+             [&](std::size_t ops) {
+                auto start = Clock::now();
+                for (std::size_t i = 0; i < ops; ++i) {
+                    std::istringstream in(text);
+                    in >> game;
+                }
+                return since(start);
+            }));
+            record("reset", boardOps, median(repeats, boardOps,
+             [&](std::size_t ops) {
+                auto start = Clock::now();
+                for (std::size_t i = 0; i < ops; ++i) {
+                    game.reset();
+                }
+                return since(start);
+            }));
+            record("draw", boardOps, median(repeats, boardOps,
+             [&](std::size_t ops) {
+                auto start = Clock::now();
+                for (std::size_t i = 0; i < ops; ++i) {
+                    canvas.clear();
+                    canvas.draw(game);
+                    canvas.display();
+                }
+                return since(start);
+            }));
+        }
+    }
+
+    if (outFile.empty()) {
+        writeJson(std::cout, results, repeats);
+    } else {
+        std::ofstream out(outFile);
+        writeJson(out, results, repeats);
+        if (!out) {
+            std::cerr << "Could not write " << outFile << "\n";
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,73 @@
+//  Copyright 2025 <Orbosa Igbinovia> [legal/copyright]
+#include <chrono>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Generator.hpp"
+#include "LevelParser.hpp"
+
+int main(int argc, char* argv[]) {
+    SB::GeneratorOptions options;
+    std::size_t count = 1;
+    std::string outFile;
+    for (int i = 1; i < argc; ++i) {
+        std::string flag = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (flag == "--width" && hasValue) {
+            options.width = std::strtoul(argv[++i], nullptr, 10);
+        } else if (flag == "--height" && hasValue) {
+            options.height = std::strtoul(argv[++i], nullptr, 10);
+        } else if (flag == "--boxes" && hasValue) {
+            options.boxes = std::strtoul(argv[++i], nullptr, 10);
+        } else if (flag == "--pulls" && hasValue) {
+            options.pulls = std::strtoul(argv[++i], nullptr, 10);
+        } else if (flag == "--walls" && hasValue) {
+            options.wallDensity = std::strtod(argv[++i], nullptr);
+        } else if (flag == "--seed" && hasValue) {
+            options.seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (flag == "--threads" && hasValue) {
+            options.threads = std::strtoul(argv[++i], nullptr, 10);
+        } else if (flag == "--count" && hasValue) {
+            count = std::strtoull(argv[++i], nullptr, 10);
+        } else if (flag == "--out" && hasValue) {
+            outFile = argv[++i];
+        } else {
+            std::cerr << "Usage: ./sokoban-gen [--width W] [--height H] "
+             "[--boxes N] [--pulls N] [--walls 0.15]\n"
+             "       [--seed S] [--threads N] [--count N] "
+             "[--out levels.lvl]\n";
+            return 1;
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<SB::GeneratedLevel> levels;
+    try {
+        levels = SB::generateLevels(options, count);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+    double seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+
+    // All levels go into one multi-level file, sokoban-pack can pack it
+    std::ofstream file;
+    if (!outFile.empty()) {
+        file.open(outFile);
+    }
+    std::ostream& out = outFile.empty() ? std::cout : file;
+    for (const SB::GeneratedLevel& level : levels) {
+        out << SB::formatLevel(level.level);
+    }
+    if (!out) {
+        std::cerr << "Could not write " << outFile << "\n";
+        return 1;
+    }
+    std::cerr << "Generated " << levels.size() << " levels in " << seconds
+     << "s\n";
+    return 0;
+}
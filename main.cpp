@@ -1,51 +1,272 @@
 //  Copyright 2025 <Orbosa Igbinovia> [legal/copyright]
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+#include "Camera.hpp"
+#include "InputQueue.hpp"
+#include "Profiler.hpp"
+#include "RenderScheduler.hpp"
+#include "Replay.hpp"
+#include "Session.hpp"
 #include "Sokoban.hpp"
+#include "SolutionCache.hpp"
+
  int main(int argc, char* argv[] ) {
-    if (argc != 2) {
-        std::cerr << "Usage: ./Sokoban < levels.txt\n";
+    if (argc < 2) {
+        std::cerr << "Usage: ./Sokoban level.lvl|levels.sbpk... [index]\n";
+        return 1;
+    }
+    // every level of every file is played in turn, a trailing number
+    // picks the one to start on
+    std::vector<std::string> inputs(argv + 1, argv + argc);
+    SB::Sokoban sokoban;
+    std::unique_ptr<SB::Session> session;
+    try {
+        std::size_t start = 0;
+        if (inputs.size() > 1 && std::all_of(inputs.back().begin(),
+         inputs.back().end(),
+         [](unsigned char c) { return std::isdigit(c); })) {
+            start = std::stoul(inputs.back());  // throws when too big
+            inputs.pop_back();
+        }
+        session = std::make_unique<SB::Session>(inputs);
+        sokoban.loadState(session->load(start));
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
         return 1;
     }
-    SB::Sokoban sokoban(argv[1]);  // reads the command line
     int ts = SB::Sokoban::TILE_SIZE;
     int windowWidth = sokoban.getWidth();
     int windowHeight = sokoban.getHeight();
 
-    // 1o tiles going up and down times the each pixel being 64 bits
-    sf::RenderWindow window
-    (sf::VideoMode(windowWidth * ts, windowHeight * ts), "Sokoban!");
+    // 1o tiles going up and down times the each pixel being 64 bits,
+    // capped to the screen so big levels scroll instead
+    sf::VideoMode desktop = sf::VideoMode::getDesktopMode();
+    unsigned int pixelsWide = std::min<unsigned int>(windowWidth * ts,
+        desktop.width * 9 / 10);
+    unsigned int pixelsHigh = std::min<unsigned int>(windowHeight * ts,
+        desktop.height * 9 / 10);
+    sf::RenderWindow window(sf::VideoMode(pixelsWide, pixelsHigh),
+        "Sokoban!");
     //  while loop
     std::cout << sokoban << std::endl;
+    window.setVerticalSyncEnabled(true);
+    SB::RenderScheduler scheduler;
+    SB::Camera camera(ts);
+    // follows the player before every frame, new positions redraw anyway
+    auto aim = [&]() {
+        camera.follow(sokoban.playerLoc());
+        window.setView(camera.view());
+    };
+    auto zoom = [&](float factor) {
+        if (camera.zoomBy(factor)) {
+            aim();
+            sokoban.invalidate();
+        }
+    };
+
+    // wins, best solutions and times survive between runs
+    SB::SolutionCache cache("sokoban-cache.bin");
+    uint64_t levelKey = 0;
+    SB::Board levelStart;  // what a win is replayed on before it is cached
+    auto showLevel = [&]() {
+        std::size_t level = session->position();
+        levelStart = sokoban.getBoard();
+        levelKey = SB::levelKey(levelStart);
+        std::string best;
+        try {
+            std::optional<SB::CacheEntry> known = cache.find(levelKey);
+            if (known && !known->solution.empty()) {
+                best = " (best " + std::to_string(known->moves) + " moves)";
+            }
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << "\n";
+        }
+        camera.reset({sokoban.getWidth(), sokoban.getHeight()},
+            window.getSize());
+        aim();
+        window.setTitle("Sokoban! " + std::to_string(level + 1) + "/"
+            + std::to_string(session->size()) + " - "
+            + session->source(level) + best);
+    };
+    // the next level is already prepared in the background, switching
+    // only rebuilds the board's vertex arrays
+    // game input waits in a queue and is applied on a fixed step, so
+    // presses that arrive during a slow frame are not played in a burst
+    using InputClock = SB::InputQueue::Clock;
+    SB::InputQueue input;
+    auto apply = [&](const SB::InputEvent& event) {
+        switch (event.action) {
+            case SB::InputAction::Move: sokoban.movePlayer(event.dir); break;
+            case SB::InputAction::Undo: sokoban.undo(); break;
+            case SB::InputAction::Redo: sokoban.redo(); break;
+            case SB::InputAction::Reset: sokoban.reset(); break;
+            case SB::InputAction::Click:
+                sokoban.clickTile(event.x, event.y);
+                break;
+            case SB::InputAction::Deselect: sokoban.clearSelection(); break;
+        }
+    };
+    auto goTo = [&](std::size_t level) {
+        try {
+            sokoban.loadState(session->load(level));
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << "\n";
+            return;
+        }
+        input.clear();  // queued moves were meant for the old level
+        showLevel();
+    };
+    showLevel();
+    const sf::Time advanceDelay = sf::seconds(1.5f);
+    sf::Clock sinceWin;
+    bool won = false;
     while (window.isOpen()) {
         sf::Event event;
-        while (window.pollEvent(event)) {
+        // sleeps until input arrives, the timer is due to tick or it is
+        // time to move on to the next level
+        sf::Time timeout = sokoban.untilRedraw();
+        if (won && session->hasNext()) {
+            timeout = std::min(timeout, advanceDelay
+                - sinceWin.getElapsedTime());
+        }
+        if (input.pending() > 0) {
+            timeout = std::min(timeout, sf::microseconds(
+                std::chrono::duration_cast<std::chrono::microseconds>(
+                    input.untilStep(InputClock::now())).count()));
+        }
+        bool pending = scheduler.waitEvent(window, event, timeout);
+        for (; pending; pending = window.pollEvent(event)) {
+            SB_PROFILE_SCOPE("input");
+            SB::InputEvent queued;
+            queued.at = InputClock::now();
             if (event.type == sf::Event::Closed) {
                 window.close();
             }
+            if (event.type == sf::Event::Resized
+             || event.type == sf::Event::GainedFocus) {
+                sokoban.invalidate();  // the window contents were lost
+                camera.resize(window.getSize());
+                aim();
+            }
             if (event.type == sf::Event::KeyPressed) {
+                queued.action = SB::InputAction::Move;
                 if (event.key.code == sf::Keyboard::Up) {
-                    sokoban.movePlayer(SB::Direction::Up);
+                    queued.dir = SB::Direction::Up;
+                    input.push(queued);
                 } else if (event.key.code == sf::Keyboard::Down) {
-                    sokoban.movePlayer(SB::Direction::Down);
+                    queued.dir = SB::Direction::Down;
+                    input.push(queued);
                 } else if (event.key.code == sf::Keyboard::Left) {
-                    sokoban.movePlayer(SB::Direction::Left);
+                    queued.dir = SB::Direction::Left;
+                    input.push(queued);
                 } else if (event.key.code == sf::Keyboard::Right) {
-                    sokoban.movePlayer(SB::Direction::Right);
+                    queued.dir = SB::Direction::Right;
+                    input.push(queued);
                 }
             }
             if (event.type == sf::Event::KeyPressed) {
                 if (event.key.code ==sf::Keyboard::R) {
-                    sokoban.reset();
+                    queued.action = SB::InputAction::Reset;
+                    input.push(queued);
                 }
             }
             if (event.type == sf::Event::KeyPressed) {
                 if (event.key.code == sf::Keyboard::U) {
-                    sokoban.undo();
+                    queued.action = SB::InputAction::Undo;
+                    input.push(queued);
+                } else if (event.key.code == sf::Keyboard::Y) {
+                    queued.action = SB::InputAction::Redo;
+                    input.push(queued);
+                } else if (event.key.code == sf::Keyboard::Equal
+                 || event.key.code == sf::Keyboard::Add) {
+                    zoom(1.25f);
+                } else if (event.key.code == sf::Keyboard::Hyphen
+                 || event.key.code == sf::Keyboard::Subtract) {
+                    zoom(0.8f);
+                } else if (event.key.code == sf::Keyboard::F3) {
+                    sokoban.toggleProfile();
+                } else if (event.key.code == sf::Keyboard::N
+                 && session->hasNext()) {
+                    goTo(session->position() + 1);
+                } else if (event.key.code == sf::Keyboard::P
+                 && session->position() > 0) {
+                    goTo(session->position() - 1);
+                }
+            }
+            if (event.type == sf::Event::MouseWheelScrolled
+             && event.mouseWheelScroll.wheel == sf::Mouse::VerticalWheel) {
+                zoom(event.mouseWheelScroll.delta > 0 ? 1.25f : 0.8f);
+            }
+            // left click walks or pushes, right click drops the selection
+            if (event.type == sf::Event::MouseButtonPressed) {
+                sf::Vector2f at = window.mapPixelToCoords(
+                    {event.mouseButton.x, event.mouseButton.y});
+                if (at.x < 0 || at.y < 0) {
+                    continue;  // in the space around the level
+                }
+                if (event.mouseButton.button == sf::Mouse::Left) {
+                    queued.action = SB::InputAction::Click;
+                    queued.x = static_cast<unsigned int>(at.x / ts);
+                    queued.y = static_cast<unsigned int>(at.y / ts);
+                    input.push(queued);
+                } else if (event.mouseButton.button == sf::Mouse::Right) {
+                    queued.action = SB::InputAction::Deselect;
+                    input.push(queued);
+                }
+            }
+        }
+        input.update(InputClock::now(), apply);
+        if (sokoban.levelComplete() != won) {
+            won = !won;
+            sinceWin.restart();
+            if (won) {
+                const SB::GameState& game = sokoban.state();
+                SB::CacheEntry entry;
+                entry.key = levelKey;
+                entry.solution = SB::toLurd(game);
+                entry.wins = 1;
+                entry.bestSeconds = sokoban.playTime().asSeconds();
+                try {
+                    cache.record(levelStart, entry);
+                } catch (const std::exception& e) {
+                    std::cerr << e.what() << "\n";
                 }
             }
         }
-        window.clear();
-        window.draw(sokoban);
-        window.display();
+        if (won && session->hasNext()
+         && sinceWin.getElapsedTime() >= advanceDelay) {
+            goTo(session->position() + 1);
+        }
+        aim();
+        // only a frame that was drawn counts as shown; events that left
+        // the screen as it was have no display latency to record
+        if (!scheduler.present(window, sokoban)) {
+            input.unchanged();
+        } else if (input.presented(InputClock::now()) > 0) {
+            sokoban.showLatency(input.summary());
+        }
+    }
+    if (input.samples() > 0) {
+        std::cerr << input.summary() << "\n";
+    }
+    // every win appends a record, so old ones pile up across games
+    try {
+        if (cache.superseded() > cache.size()) {
+            cache.compact();
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+    }
+#ifdef SOKOBAN_PROFILE
+    if (!SB::Profiler::instance().dump("sokoban-profile.json")) {
+        std::cerr << "Could not write sokoban-profile.json\n";
     }
+#endif
     return 0;
 }
@@ -0,0 +1,35 @@
+//  Copyright 2025 <Orbosa Igbinovia> [legal/copyright]
+#include <exception>
+#include <iostream>
+#include <vector>
+#include "LevelPack.hpp"
+#include "LevelParser.hpp"
+
+// Converts .lvl files into one binary level pack, in argument order
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::cerr << "Usage: ./sokoban-pack out.sbpk level.lvl...\n";
+        return 1;
+    }
+    std::vector<SB::Board> levels;
+    try {
+        for (int i = 2; i < argc; ++i) {
+            // Multi-level files contribute every level, in file order
+            SB::ParseResult result = SB::readLevels(argv[i]);
+            if (!result.ok()) {
+                std::cerr << argv[i] << ":" << result.error->line << ":"
+                 << result.error->column << ": " << result.error->message
+                 << "\n";
+                return 2;
+            }
+            levels.insert(levels.end(), result.levels.begin(),
+                result.levels.end());
+        }
+        SB::LevelPack::write(argv[1], levels);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        return 2;
+    }
+    std::cout << "Wrote " << levels.size() << " levels to " << argv[1] << "\n";
+    return 0;
+}
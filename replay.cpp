@@ -0,0 +1,64 @@
+//  Copyright 2025 <Orbosa Igbinovia> [legal/copyright]
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include "LevelPack.hpp"
+#include "LevelParser.hpp"
+#include "Replay.hpp"
+
+//  Checks a LURD solution against a level without opening a window
+int main(int argc, char* argv[]) {
+    if (argc != 3 && argc != 4) {
+        std::cerr << "Usage: ./sokoban-replay level.lvl solution.txt\n"
+         "       ./sokoban-replay levels.sbpk index solution.txt\n"
+         "Use - to read the solution from standard input.\n";
+        return 1;
+    }
+    try {
+        SB::Board level;
+        if (argc == 4) {
+            level = SB::LevelPack(argv[1]).level(std::stoul(argv[2]));
+        } else {
+            SB::ParseResult parsed = SB::readLevels(argv[1]);
+            if (!parsed.ok()) {
+                throw SB::LevelError(*parsed.error);
+            }
+            level = parsed.levels.front();
+        }
+
+        std::string file = argv[argc - 1], lurd;
+        if (file == "-") {
+            lurd.assign(std::istreambuf_iterator<char>(std::cin),
+                std::istreambuf_iterator<char>());
+        } else {
+            std::ifstream in(file, std::ios::binary);
+            if (!in) {
+                std::cerr << "Unable to open file: " << file << "\n";
+                return 1;
+            }
+            lurd.assign(std::istreambuf_iterator<char>(in),
+                std::istreambuf_iterator<char>());
+        }
+
+        SB::Replay replay{SB::GameState(level)};
+        if (!replay.play(lurd)) {
+            const SB::ReplayError& error = *replay.error();
+            std::cout << "invalid at move " << error.move + 1
+             << " (character " << error.offset + 1 << "): "
+             << error.message << "\n";
+            return 2;
+        }
+        std::size_t pushes = 0;
+        for (const SB::moveRecord& move : replay.state().history()) {
+            pushes += move.box >= 0;
+        }
+        std::cout << (replay.solves() ? "solved" : "not solved") << " in "
+         << replay.size() << " moves, " << pushes << " pushes\n";
+        return replay.solves() ? 0 : 2;
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+}
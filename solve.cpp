@@ -0,0 +1,91 @@
+//  Copyright 2025 <Orbosa Igbinovia> [legal/copyright]
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <string>
+#include "LevelParser.hpp"
+#include "Replay.hpp"
+#include "Solver.hpp"
+
+int main(int argc, char* argv[]) {
+    SB::SolverOptions options;
+    int first = 1;
+    for (; first < argc && argv[first][0] == '-'; ++first) {
+        std::string flag = argv[first];
+        if (flag == "--moves") {
+            options.mode = SB::SolveMode::Moves;
+        } else if (flag == "--ida") {
+            options.algorithm = SB::SearchAlgorithm::IDAStar;
+        } else if (flag == "--portfolio") {
+            options.algorithm = SB::SearchAlgorithm::Portfolio;
+        } else if (flag == "--threads" && first + 1 < argc) {
+            options.threads = static_cast<unsigned int>(
+                std::strtoul(argv[++first], nullptr, 10));
+        } else if (flag == "--max-nodes" && first + 1 < argc) {
+            options.maxNodes = std::strtoull(argv[++first], nullptr, 10);
+        } else {
+            first = argc;
+            break;
+        }
+    }
+    if (first >= argc) {
+        std::cerr << "Usage: ./sokoban-solve [--moves] [--ida] "
+         "[--max-nodes N]\n"
+         "       [--portfolio [--threads N]] level.lvl...\n";
+        return 1;
+    }
+
+    int unsolved = 0;
+    for (int i = first; i < argc; ++i) {
+        SB::ParseResult parsed;
+        try {
+            parsed = SB::readLevels(argv[i]);
+            if (!parsed.ok()) {
+                throw SB::LevelError(*parsed.error);
+            }
+        } catch (const std::exception& e) {
+            ++unsolved;
+            std::cerr << argv[i] << ": " << e.what() << "\n";
+            continue;
+        }
+        if (parsed.levels.empty()) {
+            ++unsolved;
+            std::cerr << argv[i] << ": no levels\n";
+        }
+        // Files holding several levels name each one by its 1-based number
+        for (std::size_t n = 0; n < parsed.levels.size(); ++n) {
+            std::string name = argv[i];
+            if (parsed.levels.size() > 1) name += "#" + std::to_string(n + 1);
+            try {
+                SB::GameState level(parsed.levels[n]);
+                SB::SolveResult result = SB::Solver(level).solve(options);
+                std::cout << name << ": ";
+                if (!result.solved) {
+                    ++unsolved;
+                    std::cout << "no solution";
+                } else {
+                    std::cout << result.moves.size() << " moves, "
+                     << result.pushes << " pushes";
+                    if (!result.strategy.empty()) {
+                        std::cout << " (" << result.strategy << ")";
+                    }
+                }
+                std::cout << ", " << result.nodesExpanded << " nodes in "
+                 << result.seconds << "s (" << result.nodesPerSecond
+                 << " nodes/s)\n";
+                if (result.solved) {
+                    // LURD, with pushes in upper case
+                    SB::GameState replay = level;
+                    for (SB::Direction dir : result.moves) {
+                        replay.move(dir);
+                    }
+                    std::cout << SB::toLurd(replay) << "\n";
+                }
+            } catch (const std::exception& e) {
+                ++unsolved;
+                std::cerr << name << ": " << e.what() << "\n";
+            }
+        }
+    }
+    return unsolved == 0 ? 0 : 2;
+}
@@ -1,7 +1,33 @@
 //  Copyright 2025 <Orbosa Igbinovia> [legal/copyright]
 #include <iostream>
+#include <sstream>
 #include <string>
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include "AssetCache.hpp"
+#include "BatchSim.hpp"
+#include "Camera.hpp"
+#include "FixedBoard.hpp"
+#include "GameState.hpp"
+#include "Generator.hpp"
+#include "InputQueue.hpp"
+#include "LevelPack.hpp"
+#include "LevelParser.hpp"
+#include "PathPlanner.hpp"
+#include "Profiler.hpp"
+#include "RenderScheduler.hpp"
+#include "Replay.hpp"
+#include "Session.hpp"
 #include "Sokoban.hpp"
+#include "SolutionCache.hpp"
+#include "Solver.hpp"
+#include "ThreadPool.hpp"
+#include "Verifier.hpp"
 #define BOOST_TEST_MODULE Main
 #include <boost/test/included/unit_test.hpp>
 
@@ -165,7 +191,1128 @@ BOOST_AUTO_TEST_CASE(Player_Cannot_Move_Off_Screen) {
     BOOST_CHECK(s.playerLoc() == secbefore);
 }
 
+BOOST_AUTO_TEST_CASE(Solver_Solution_Wins_The_Level) {
+    SB::Sokoban s("level4.lvl");
+    SB::SolveResult result = SB::Solver(s.state()).solve();
+    BOOST_REQUIRE(result.solved);
+    for (SB::Direction dir : result.moves) {
+        s.movePlayer(dir);
+    }
+    BOOST_REQUIRE_EQUAL(s.isWon(), true);
+}
+
+BOOST_AUTO_TEST_CASE(Solver_IDA_Finds_Same_Push_Count) {
+    SB::Sokoban s("level2.lvl");
+    SB::SolverOptions options;
+    SB::SolveResult astar = SB::Solver(s.state()).solve(options);
+    options.algorithm = SB::SearchAlgorithm::IDAStar;
+    SB::SolveResult ida = SB::Solver(s.state()).solve(options);
+    BOOST_REQUIRE(astar.solved && ida.solved);
+    BOOST_CHECK_EQUAL(astar.pushes, ida.pushes);
+}
+
+BOOST_AUTO_TEST_CASE(Solver_Move_Optimal_Is_Shortest) {
+    SB::Sokoban s("level6.lvl");
+    SB::SolverOptions options;
+    SB::SolveResult pushes = SB::Solver(s.state()).solve(options);
+    options.mode = SB::SolveMode::Moves;
+    SB::SolveResult moves = SB::Solver(s.state()).solve(options);
+    BOOST_REQUIRE(moves.solved);
+    BOOST_CHECK(moves.moves.size() <= pushes.moves.size());
+    BOOST_CHECK_GE(moves.nodesExpanded, 1u);
+
+    for (SB::Direction dir : moves.moves) {
+        s.movePlayer(dir);
+    }
+    BOOST_REQUIRE_EQUAL(s.isWon(), true);
+}
+
+BOOST_AUTO_TEST_CASE(Solver_Portfolio_Solves_On_Any_Thread_Count) {
+    SB::GeneratorOptions gen;
+    gen.width = 14;
+    gen.height = 14;
+    gen.boxes = 6;
+    gen.pulls = 300;
+    SB::GameState level(SB::generateLevel(gen, 5).level);
+    SB::SolverOptions options;
+    options.algorithm = SB::SearchAlgorithm::Portfolio;
+    for (unsigned int threads : {1u, 2u, 4u}) {
+        options.threads = threads;
+        SB::SolveResult result = SB::Solver(level).solve(options);
+        BOOST_REQUIRE(result.solved);
+        BOOST_CHECK(!result.strategy.empty());
+        // Joined forward and backward paths must still play out
+        SB::GameState played = level;
+        for (SB::Direction dir : result.moves) {
+            BOOST_REQUIRE(played.move(dir));
+        }
+        BOOST_CHECK(played.isWon());
+    }
+
+    // A box stuck in a corner is proven lost, not out of budget
+    SB::ParseResult stuck = SB::parseLevels("4 5\n#####\n#A.a#\n#..@#\n"
+        "#####\n");
+    BOOST_REQUIRE(stuck.ok());
+    options.threads = 2;
+    SB::SolveResult lost = SB::Solver(SB::GameState(stuck.levels.front()))
+        .solve(options);
+    BOOST_CHECK(!lost.solved);
+    BOOST_CHECK(!lost.outOfBudget);
+}
+
+BOOST_AUTO_TEST_CASE(Solver_Portfolio_Survives_A_Full_Table) {
+    SB::GeneratorOptions gen;
+    gen.width = 12;
+    gen.height = 12;
+    gen.boxes = 4;
+    gen.pulls = 200;
+    SB::GameState level(SB::generateLevel(gen, 9).level);
+    SB::SolverOptions options;
+    options.algorithm = SB::SearchAlgorithm::Portfolio;
+    options.threads = 4;
+    // 64 slots: most positions only fit the runs' own indexes
+    options.sharedPositions = 1;
+    SB::SolveResult result = SB::Solver(level).solve(options);
+    BOOST_REQUIRE(result.solved);
+    SB::GameState played = level;
+    for (SB::Direction dir : result.moves) {
+        BOOST_REQUIRE(played.move(dir));
+    }
+    BOOST_CHECK(played.isWon());
+
+    // Proven lost only once every search has run out
+    SB::ParseResult blocked = SB::parseLevels("3 9\n#########\n"
+        "#@.AA.aa#\n#########\n");
+    BOOST_REQUIRE(blocked.ok());
+    SB::SolveResult lost = SB::Solver(SB::GameState(blocked.levels.front()))
+        .solve(options);
+    BOOST_CHECK(!lost.solved);
+    BOOST_CHECK(!lost.outOfBudget);
+}
+
+BOOST_AUTO_TEST_CASE(Solver_Flags_Corners_As_Dead) {
+    SB::Sokoban s("level1.lvl");
+    SB::Solver solver(s.state());
+    BOOST_CHECK(solver.isDeadSquare(1, 1));   // corner without a goal
+    BOOST_CHECK(!solver.isDeadSquare(5, 1));  // goal square
+    BOOST_CHECK(!solver.isDeadSquare(3, 3));
+}
+
+BOOST_AUTO_TEST_CASE(Board_Keeps_Goal_Under_Box) {
+    SB::Sokoban s("level1.lvl");
+    BOOST_CHECK_EQUAL(s.getTile(0, 0), '#');
+    BOOST_CHECK_EQUAL(s.getTile(3, 6), '@');
+    BOOST_CHECK_EQUAL(s.getTile(5, 2), 'A');
+    BOOST_CHECK_EQUAL(s.getTile(5, 1), 'a');
+    BOOST_CHECK_EQUAL(s.getTile(10, 0), '?');
+
+    // Walk around and push the box at (5,2) up onto the goal at (5,1)
+    s.movePlayer(SB::Direction::Up);
+    s.movePlayer(SB::Direction::Up);
+    s.movePlayer(SB::Direction::Up);
+    s.movePlayer(SB::Direction::Right);
+    s.movePlayer(SB::Direction::Right);
+    s.movePlayer(SB::Direction::Up);
+    BOOST_CHECK_EQUAL(s.getTile(5, 1), 'A');
+    BOOST_CHECK(s.getBoard().isGoal(s.getBoard().index(5, 1)));
+}
+
+BOOST_AUTO_TEST_CASE(Board_Border_Blocks_Open_Edges) {
+    // walkover.lvl has no walls, so the padded border is all that stops us
+    SB::Sokoban s("walkover.lvl");
+    s.movePlayer(SB::Direction::Down);
+    BOOST_CHECK(s.playerLoc() == sf::Vector2u(2, 5));
+    s.movePlayer(SB::Direction::Left);
+    s.movePlayer(SB::Direction::Left);
+    s.movePlayer(SB::Direction::Left);
+    BOOST_CHECK(s.playerLoc() == sf::Vector2u(0, 5));
+}
+
+BOOST_AUTO_TEST_CASE(Undo_Redo_Walks_The_Journal) {
+    SB::Sokoban s("level1.lvl");
+    s.movePlayer(SB::Direction::Right);
+    s.movePlayer(SB::Direction::Right);
+    s.movePlayer(SB::Direction::Right);  // push box from (6,6) to (7,6)
+    s.movePlayer(SB::Direction::Up);
+    BOOST_REQUIRE_EQUAL(s.historySize(), 4u);
+
+    s.undo();
+    s.undo();  // takes the push back
+    BOOST_CHECK(s.playerLoc() == sf::Vector2u(5, 6));
+    BOOST_CHECK_EQUAL(s.getTile(6, 6), 'A');
+    BOOST_CHECK_EQUAL(s.getTile(7, 6), '.');
+
+    s.redo();
+    BOOST_CHECK(s.playerLoc() == sf::Vector2u(6, 6));
+    BOOST_CHECK_EQUAL(s.getTile(7, 6), 'A');
+    BOOST_CHECK(s.getBoxes()[1] == sf::Vector2u(7, 6));
 
+    s.jumpTo(0);
+    BOOST_CHECK(s.playerLoc() == sf::Vector2u(3, 6));
+    s.jumpTo(s.historySize());
+    BOOST_CHECK(s.playerLoc() == sf::Vector2u(6, 5));
+    BOOST_CHECK_EQUAL(s.historyPosition(), 4u);
+}
+
+BOOST_AUTO_TEST_CASE(Blocked_Moves_Are_Not_Recorded) {
+    SB::Sokoban s("level1.lvl");
+    s.movePlayer(SB::Direction::Left);
+    s.movePlayer(SB::Direction::Left);
+    s.movePlayer(SB::Direction::Left);  // wall
+    BOOST_CHECK_EQUAL(s.historySize(), 2u);
+
+    // A fresh move after an undo drops the redo branch
+    s.undo();
+    s.movePlayer(SB::Direction::Up);
+    BOOST_CHECK_EQUAL(s.historySize(), 2u);
+    s.redo();
+    BOOST_CHECK(s.playerLoc() == sf::Vector2u(2, 5));
+}
+
+BOOST_AUTO_TEST_CASE(Win_Check_Follows_Undo) {
+    SB::Sokoban s("level5.lvl");
+    const SB::Direction path[] = {
+        SB::Direction::Right, SB::Direction::Up, SB::Direction::Up,
+        SB::Direction::Up, SB::Direction::Up, SB::Direction::Left,
+        SB::Direction::Up, SB::Direction::Right, SB::Direction::Right,
+        SB::Direction::Right, SB::Direction::Right};
+    for (SB::Direction dir : path) {
+        s.movePlayer(dir);
+    }
+    BOOST_REQUIRE_EQUAL(s.isWon(), true);
+
+    // Pull the last box back off its goal, then push it on again
+    s.undo();
+    BOOST_CHECK_EQUAL(s.isWon(), false);
+    s.redo();
+    BOOST_CHECK_EQUAL(s.isWon(), true);
+    s.reset();
+    BOOST_CHECK_EQUAL(s.isWon(), false);
+}
+
+BOOST_AUTO_TEST_CASE(Assets_Are_Decoded_Once) {
+    SB::Sokoban first("level1.lvl");
+    SB::AssetStats before = SB::AssetCache::instance().stats();
+    SB::Sokoban second("level2.lvl");
+    second.movePlayer(SB::Direction::Left);
+    second.movePlayer(SB::Direction::Up);
+    SB::AssetStats after = SB::AssetCache::instance().stats();
+
+    BOOST_CHECK_EQUAL(after.imagesDecoded, before.imagesDecoded);
+    BOOST_CHECK_EQUAL(after.fontsLoaded, before.fontsLoaded);
+    BOOST_CHECK_EQUAL(after.atlasesBuilt, before.atlasesBuilt);
+    BOOST_CHECK_GT(after.cacheHits, before.cacheHits);
+}
+
+BOOST_AUTO_TEST_CASE(Level_Pack_Round_Trip) {
+    SB::Sokoban one("level1.lvl"), four("level4.lvl");
+    SB::LevelPack::write("test_levels.sbpk", {one.getBoard(), four.getBoard()});
+    BOOST_REQUIRE(SB::LevelPack::isPack("test_levels.sbpk"));
+    BOOST_CHECK(!SB::LevelPack::isPack("level1.lvl"));
+    {
+        SB::LevelPack pack("test_levels.sbpk");
+        BOOST_REQUIRE_EQUAL(pack.size(), 2u);
+        BOOST_CHECK_EQUAL(pack.width(1), 12u);
+        BOOST_CHECK_EQUAL(pack.height(1), 8u);
+
+        SB::Sokoban loaded;
+        loaded.loadBoard(pack.level(1));
+        for (unsigned int y = 0; y < four.getHeight(); ++y) {
+            for (unsigned int x = 0; x < four.getWidth(); ++x) {
+                BOOST_CHECK_EQUAL(loaded.getTile(x, y), four.getTile(x, y));
+            }
+        }
+        BOOST_CHECK(loaded.playerLoc() == four.playerLoc());
+        BOOST_CHECK_EQUAL(loaded.getGoals().size(), 3u);
+        BOOST_CHECK_THROW(pack.level(2), std::out_of_range);
+    }
+    std::remove("test_levels.sbpk");
+}
+
+BOOST_AUTO_TEST_CASE(Parser_Reads_Boxes_On_Goals) {
+    // swapoff.lvl uses '1' for a box already sitting on a goal
+    SB::Sokoban s("swapoff.lvl");
+    BOOST_CHECK_EQUAL(s.getBoxes().size(), 3u);
+    BOOST_CHECK_EQUAL(s.getGoals().size(), 3u);
+    BOOST_CHECK_EQUAL(s.isWon(), false);
+}
+
+BOOST_AUTO_TEST_CASE(Parser_Reports_Line_And_Column) {
+    SB::ParseResult stray = SB::parseLevels("3 3\n###\n#@x\n###\n");
+    BOOST_REQUIRE(!stray.ok());
+    BOOST_CHECK_EQUAL(stray.error->line, 3u);
+    BOOST_CHECK_EQUAL(stray.error->column, 3u);
 
+    SB::ParseResult shortRow = SB::parseLevels("2 4\n#@Aa\n##\n");
+    BOOST_REQUIRE(!shortRow.ok());
+    BOOST_CHECK_EQUAL(shortRow.error->line, 3u);
+    BOOST_CHECK_EQUAL(shortRow.error->column, 3u);
+
+    SB::ParseResult noPlayer = SB::parseLevels("1 3\n.Aa\n");
+    BOOST_REQUIRE(!noPlayer.ok());
+    BOOST_CHECK_EQUAL(noPlayer.error->line, 1u);
+
+    SB::ParseResult twoPlayers = SB::parseLevels("1 4\n@Aa@\n");
+    BOOST_REQUIRE(!twoPlayers.ok());
+    BOOST_CHECK_EQUAL(twoPlayers.error->column, 4u);
+
+    SB::ParseResult lying = SB::parseLevels("100000 100000\n@Aa\n");
+    BOOST_CHECK(!lying.ok());
+
+    SB::ParseOptions strict;
+    strict.requireMatchingCounts = true;
+    BOOST_CHECK(SB::parseLevels("1 4\n@AAa\n").ok());
+    BOOST_CHECK(!SB::parseLevels("1 4\n@AAa\n", strict).ok());
+}
+
+BOOST_AUTO_TEST_CASE(Parser_Reads_Xsb_Packs) {
+    const char* text =
+        "; two small levels\n"
+        "Title: first\n"
+        "#####\n"
+        "#@$.#\n"
+        "#####\n"
+        "\n"
+        "Title: second\n"
+        "####\n"
+        "#+ #\n"
+        "#*$#\n"
+        "# .#\n"
+        "####\n";
+    SB::ParseResult result = SB::parseLevels(text);
+    BOOST_REQUIRE(result.ok());
+    BOOST_REQUIRE_EQUAL(result.levels.size(), 2u);
+
+    SB::Sokoban s;
+    s.loadBoard(result.levels[1]);
+    BOOST_CHECK(s.playerLoc() == sf::Vector2u(1, 1));
+    BOOST_CHECK_EQUAL(s.getGoals().size(), 3u);
+    BOOST_CHECK_EQUAL(s.getBoxes().size(), 2u);
+
+    // operator>> pulls one level at a time off the stream
+    std::istringstream in(text);
+    SB::Sokoban first, second;
+    BOOST_REQUIRE(in >> first >> second);
+    BOOST_CHECK_EQUAL(first.getWidth(), 5u);
+    BOOST_CHECK_EQUAL(second.getHeight(), 5u);
+}
+
+BOOST_AUTO_TEST_CASE(Bad_Level_Leaves_Game_Untouched) {
+    SB::Sokoban s("level1.lvl");
+    std::istringstream in("2 2\n@?\n..\n");
+    BOOST_CHECK(!(in >> s));
+    BOOST_CHECK_EQUAL(s.getWidth(), 10u);
+    BOOST_CHECK(s.playerLoc() == sf::Vector2u(3, 6));
+}
+
+BOOST_AUTO_TEST_CASE(Game_State_Runs_Without_Sfml) {
+    SB::ParseResult parsed = SB::readLevels("level1.lvl");
+    BOOST_REQUIRE(parsed.ok());
+    SB::GameState game(parsed.levels.front());
+    const SB::Board& board = game.board();
+    BOOST_CHECK_EQUAL(game.player(), board.index(3, 6));
+
+    // Copies are independent games
+    SB::GameState fork = game;
+    BOOST_REQUIRE(fork.move(SB::Direction::Up));
+    BOOST_CHECK_EQUAL(fork.player(), board.index(3, 5));
+    BOOST_CHECK_EQUAL(game.player(), board.index(3, 6));
+    BOOST_CHECK_EQUAL(game.moves(), 0u);
+
+    // Same push as Board_Keeps_Goal_Under_Box, ending on the goal
+    for (SB::Direction dir : {SB::Direction::Up, SB::Direction::Up,
+     SB::Direction::Right, SB::Direction::Right, SB::Direction::Up}) {
+        BOOST_REQUIRE(fork.move(dir));
+    }
+    // The box now sits against the top wall
+    BOOST_CHECK(!fork.canMove(SB::Direction::Up));
+    BOOST_CHECK(!fork.move(SB::Direction::Up));
+    BOOST_CHECK_EQUAL(fork.history().size(), 6u);
+    BOOST_CHECK_EQUAL(fork.boxesOnGoals(), 1u);
+    fork.reset();
+    BOOST_CHECK_EQUAL(fork.boxesOnGoals(), 0u);
+    BOOST_CHECK_EQUAL(fork.player(), board.index(3, 6));
+}
+
+BOOST_AUTO_TEST_CASE(Deadlock_Flags_Corner_Push_Until_Undone) {
+    SB::ParseResult parsed = SB::parseLevels(
+        "######\n"
+        "#    #\n"
+        "# $  #\n"
+        "# @ .#\n"
+        "######\n");
+    BOOST_REQUIRE(parsed.ok());
+    SB::Sokoban s;
+    s.loadBoard(parsed.levels.front());
+    const SB::Board& board = s.getBoard();
+    BOOST_CHECK(s.state().deadlocks().isDeadSquare(board.index(2, 1)));
+    BOOST_CHECK(!s.state().deadlocks().isDeadSquare(board.index(2, 2)));
+    BOOST_CHECK(!s.isDeadlocked());
+
+    s.movePlayer(SB::Direction::Up);  // box against a wall with no goal
+    BOOST_CHECK(s.isDeadlocked());
+    s.undo();
+    BOOST_CHECK(!s.isDeadlocked());
+    s.redo();
+    BOOST_CHECK(s.isDeadlocked());
+}
+
+BOOST_AUTO_TEST_CASE(Deadlock_Finds_Frozen_Boxes) {
+    SB::ParseResult parsed = SB::parseLevels(
+        "#######\n"
+        "#. $ .#\n"
+        "# $   #\n"
+        "# @   #\n"
+        "#######\n");
+    BOOST_REQUIRE(parsed.ok());
+    SB::GameState game(parsed.levels.front());
+    // Both squares are live on their own, side by side they freeze
+    BOOST_CHECK(!game.deadlocks().isDeadSquare(game.board().index(2, 1)));
+    BOOST_CHECK(!game.isDeadlocked());
+    BOOST_REQUIRE(game.move(SB::Direction::Up));
+    BOOST_CHECK(game.isDeadlocked());
+    BOOST_CHECK(game.deadlocks().isLost(game.board()));
+    game.undo();
+    BOOST_CHECK(!game.deadlocks().isLost(game.board()));
+}
 
+BOOST_AUTO_TEST_CASE(Deadlock_Finds_Frozen_Corrals) {
+    // The box pushed into the doorway is held by the one behind it, and
+    // the player can never get round into the room
+    SB::ParseResult parsed = SB::parseLevels(
+        "#######\n"
+        "# .   #\n"
+        "#  $  #\n"
+        "### ###\n"
+        "#  $  #\n"
+        "#. @  #\n"
+        "#######\n");
+    BOOST_REQUIRE(parsed.ok());
+    SB::GameState game(parsed.levels.front());
+    BOOST_REQUIRE(game.move(SB::Direction::Up));
+    // Neither box is frozen on its own
+    BOOST_CHECK(game.isDeadlocked());
+    BOOST_CHECK(game.deadlocks().isLost(game.board()));
+    game.undo();
+    BOOST_CHECK(!game.deadlocks().isLost(game.board()));
 
+    // Alone in the doorway the box can still go on into the room
+    SB::ParseResult open = SB::parseLevels(
+        "#######\n"
+        "# .   #\n"
+        "#     #\n"
+        "### ###\n"
+        "#  $  #\n"
+        "#  @  #\n"
+        "#######\n");
+    BOOST_REQUIRE(open.ok());
+    SB::GameState free(open.levels.front());
+    BOOST_REQUIRE(free.move(SB::Direction::Up));
+    BOOST_CHECK(!free.isDeadlocked());
+}
+
+BOOST_AUTO_TEST_CASE(Deadlock_Ignores_Spare_Boxes) {
+    // Two boxes, one goal: the cornered box is just a spare
+    SB::ParseResult parsed = SB::parseLevels(
+        "######\n"
+        "#.$@$#\n"
+        "#    #\n"
+        "######\n");
+    BOOST_REQUIRE(parsed.ok());
+    SB::GameState game(parsed.levels.front());
+    BOOST_CHECK(!game.isDeadlocked());
+    BOOST_REQUIRE(game.move(SB::Direction::Left));
+    BOOST_CHECK(game.isWon());
+    BOOST_CHECK(!game.isDeadlocked());
+
+    // One spare may go against the wall, the second one loses
+    SB::ParseResult two = SB::parseLevels(
+        "#######\n"
+        "#     #\n"
+        "# $ $ #\n"
+        "#  @  #\n"
+        "#.    #\n"
+        "#######\n");
+    BOOST_REQUIRE(two.ok());
+    SB::GameState spare(two.levels.front());
+    BOOST_REQUIRE(spare.moveAll({SB::Direction::Left, SB::Direction::Up}));
+    BOOST_CHECK(!spare.isDeadlocked());
+    BOOST_REQUIRE(spare.moveAll({SB::Direction::Right, SB::Direction::Down,
+        SB::Direction::Right, SB::Direction::Up}));
+    BOOST_CHECK(spare.isDeadlocked());
+    spare.undo();
+    BOOST_CHECK(!spare.isDeadlocked());
+}
+
+BOOST_AUTO_TEST_CASE(Zobrist_Hash_Identifies_Positions) {
+    SB::ParseResult parsed = SB::readLevels("level1.lvl");
+    BOOST_REQUIRE(parsed.ok());
+    SB::GameState a(parsed.levels.front());
+    SB::GameState b = a;
+    const uint64_t start = a.hash();
+
+    // Walking out and back is a repetition
+    a.move(SB::Direction::Right);
+    BOOST_CHECK(a.hash() != start);
+    a.move(SB::Direction::Left);
+    BOOST_CHECK_EQUAL(a.hash(), start);
+
+    // Different walks to the same square, plus the incremental hash
+    // agrees with a fresh scan of the resulting board
+    BOOST_REQUIRE(a.move(SB::Direction::Up));
+    BOOST_REQUIRE(a.move(SB::Direction::Left));
+    BOOST_REQUIRE(b.move(SB::Direction::Left));
+    BOOST_REQUIRE(b.move(SB::Direction::Up));
+    BOOST_CHECK_EQUAL(a.hash(), b.hash());
+    BOOST_CHECK_EQUAL(SB::GameState(a.board()).hash(), a.hash());
+
+    // Only the canonical key ignores where in its region the player is
+    BOOST_REQUIRE(b.move(SB::Direction::Up));
+    BOOST_CHECK(a.hash() != b.hash());
+    BOOST_CHECK_EQUAL(a.canonicalHash(), b.canonicalHash());
+    BOOST_CHECK(a.packedKey() == b.packedKey());
+    BOOST_CHECK_EQUAL(a.packedKey().size(), 2u * (1 + a.boxes().size()));
+}
+
+BOOST_AUTO_TEST_CASE(Packed_Key_Restores_Position) {
+    SB::ParseResult parsed = SB::readLevels("level1.lvl");
+    BOOST_REQUIRE(parsed.ok());
+    SB::GameState game(parsed.levels.front());
+    for (SB::Direction dir : {SB::Direction::Up, SB::Direction::Up,
+     SB::Direction::Up, SB::Direction::Right, SB::Direction::Right,
+     SB::Direction::Up}) {
+        BOOST_REQUIRE(game.move(dir));
+    }
+    std::string key = game.packedKey();
+
+    SB::GameState copy(parsed.levels.front());
+    BOOST_REQUIRE(copy.restore(key));
+    BOOST_CHECK_EQUAL(copy.canonicalHash(), game.canonicalHash());
+    BOOST_CHECK_EQUAL(copy.boxesOnGoals(), 1u);
+    BOOST_CHECK_EQUAL(copy.history().size(), 0u);
+    BOOST_CHECK(!copy.restore(key.substr(2)));
+}
+
+BOOST_AUTO_TEST_CASE(Thread_Pool_Runs_Spawned_Tasks) {
+    std::atomic<int> ran{0};
+    SB::ThreadPool pool(3);
+    for (int i = 0; i < 20; ++i) {
+        pool.submit([&] {
+            ++ran;
+            // tasks may queue more work, wait() covers it too
+            pool.submit([&] { ++ran; });
+        });
+    }
+    pool.wait();
+    BOOST_CHECK_EQUAL(ran.load(), 40);
+
+    pool.submit([] { throw std::runtime_error("task failed"); });
+    BOOST_CHECK_THROW(pool.wait(), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(Verifier_Reports_Every_Level) {
+    const char* broken = "verify_broken.lvl";
+    {
+        std::ofstream out(broken);
+        out << "#####\n#@$.#\n#####\n\n#####\n#@x.#\n#####\n";
+    }
+    SB::VerifyOptions options;
+    options.threads = 2;
+    SB::VerifyReport report = SB::verify({"level5.lvl", broken}, options);
+    std::remove(broken);
+
+    BOOST_REQUIRE_EQUAL(report.levels.size(), 3u);
+    BOOST_CHECK_EQUAL(report.levels[0].source, "level5.lvl");
+    BOOST_CHECK_EQUAL(report.levels[0].status, SB::LevelReport::Solved);
+    BOOST_CHECK_EQUAL(report.levels[0].warnings.size(), 1u);  // 2 boxes
+    BOOST_CHECK_EQUAL(report.levels[1].status, SB::LevelReport::Solved);
+    BOOST_CHECK_EQUAL(report.levels[2].index, 1u);
+    BOOST_CHECK_EQUAL(report.levels[2].status, SB::LevelReport::Invalid);
+    BOOST_CHECK(report.levels[2].error.find("line 6") != std::string::npos);
+
+    std::ostringstream json;
+    SB::writeJson(json, report);
+    BOOST_CHECK(json.str().find("\"invalid\": 1") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(Replay_Checks_Lurd_And_Seeks) {
+    SB::ParseResult parsed = SB::readLevels("level4.lvl");
+    BOOST_REQUIRE(parsed.ok());
+    SB::GameState start(parsed.levels.front());
+    SB::SolveResult solution = SB::Solver(start).solve();
+    BOOST_REQUIRE(solution.solved);
+
+    SB::GameState played = start;
+    for (SB::Direction dir : solution.moves) {
+        played.move(dir);
+    }
+    std::string lurd = SB::toLurd(played);
+    BOOST_CHECK_EQUAL(lurd.size(), solution.moves.size());
+    BOOST_CHECK_EQUAL(std::count_if(lurd.begin(), lurd.end(), ::isupper),
+        static_cast<long>(solution.pushes));
+
+    // Small interval so seeking crosses several checkpoints
+    SB::Replay replay(start, 8);
+    BOOST_REQUIRE(replay.play(lurd));
+    BOOST_CHECK(replay.solves());
+    BOOST_CHECK_EQUAL(replay.state().hash(), played.hash());
+
+    SB::GameState middle = start;
+    for (std::size_t i = 0; i < 21; ++i) {
+        middle.move(solution.moves[i]);
+    }
+    replay.seek(21);
+    BOOST_CHECK_EQUAL(replay.position(), 21u);
+    BOOST_CHECK_EQUAL(replay.state().hash(), middle.hash());
+    BOOST_CHECK_EQUAL(replay.state().moves(), 21u);
+    replay.seek(3);
+    replay.seek(replay.size());
+    BOOST_CHECK(replay.solves());
+}
+
+BOOST_AUTO_TEST_CASE(Replay_Rejects_Wrong_Moves) {
+    SB::ParseResult parsed = SB::readLevels("level1.lvl");
+    BOOST_REQUIRE(parsed.ok());
+    SB::GameState start(parsed.levels.front());
+
+    // Run lengths expand, a lower case push is refused
+    SB::Replay counted(start);
+    BOOST_CHECK(counted.play("3u 2r"));
+    BOOST_CHECK_EQUAL(counted.size(), 5u);
+    BOOST_CHECK(!counted.play("u"));
+    BOOST_CHECK_EQUAL(counted.error()->move, 5u);
+    BOOST_CHECK(counted.play("U") == false);  // stays failed
+
+    SB::Replay blocked(start);
+    BOOST_CHECK(!blocked.play("uuuuuu"));
+    BOOST_CHECK_EQUAL(blocked.error()->message, "move is blocked");
+    BOOST_CHECK(!blocked.solves());
+
+    SB::Replay junk(start);
+    BOOST_CHECK(!junk.play("ux"));
+    BOOST_CHECK_EQUAL(junk.error()->offset, 1u);
+}
+
+BOOST_AUTO_TEST_CASE(Path_Planner_Walks_Shortest_Path) {
+    SB::ParseResult parsed = SB::readLevels("level1.lvl");
+    BOOST_REQUIRE(parsed.ok());
+    SB::GameState game(parsed.levels.front());
+    const SB::Board& board = game.board();
+    SB::PathPlanner planner;
+
+    // 64 inner squares less the 4 wall tiles and the 2 boxes
+    BOOST_CHECK_EQUAL(planner.region(game).size(), 58u);
+    BOOST_CHECK(!planner.canReach(game, board.index(4, 4)));
+
+    std::vector<SB::Direction> path;
+    BOOST_REQUIRE(planner.walkTo(game, board.index(1, 1), path));
+    BOOST_CHECK_EQUAL(path.size(), 7u);
+    BOOST_REQUIRE(game.moveAll(path));
+    BOOST_CHECK_EQUAL(game.player(), board.index(1, 1));
+    BOOST_CHECK_EQUAL(game.boxesOnGoals(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(Path_Planner_Pushes_As_One_Undo_Step) {
+    SB::ParseResult parsed = SB::readLevels("level1.lvl");
+    BOOST_REQUIRE(parsed.ok());
+    SB::GameState game(parsed.levels.front());
+    const SB::Board& board = game.board();
+    SB::PathPlanner planner;
+
+    std::vector<SB::Direction> path;
+    BOOST_CHECK(!planner.pushTo(game, board.index(5, 2), board.index(4, 4),
+        path));
+    BOOST_REQUIRE(planner.pushTo(game, board.index(5, 2), board.index(5, 1),
+        path));
+    BOOST_CHECK(path.back() == SB::Direction::Up);
+    BOOST_REQUIRE(game.moveAll(path));
+    BOOST_CHECK_EQUAL(game.boxesOnGoals(), 1u);
+    BOOST_CHECK_EQUAL(game.historyPosition(), path.size());
+
+    // The whole macro comes back and goes again in one step
+    BOOST_CHECK(game.undo());
+    BOOST_CHECK_EQUAL(game.historyPosition(), 0u);
+    BOOST_CHECK_EQUAL(game.player(), board.index(3, 6));
+    BOOST_CHECK(game.redo());
+    BOOST_CHECK_EQUAL(game.historyPosition(), path.size());
+    BOOST_CHECK(game.move(SB::Direction::Down));
+    BOOST_CHECK(game.undo());
+    BOOST_CHECK_EQUAL(game.historyPosition(), path.size());
+
+    // A blocked path leaves the redo history alone
+    BOOST_CHECK(game.undo());
+    std::vector<SB::Direction> blocked = {SB::Direction::Left,
+        SB::Direction::Left, SB::Direction::Left, SB::Direction::Left};
+    BOOST_CHECK(!game.moveAll(blocked));
+    BOOST_CHECK_EQUAL(game.historyPosition(), 0u);
+    BOOST_CHECK_EQUAL(game.player(), board.index(3, 6));
+    BOOST_CHECK(game.redo());
+    BOOST_CHECK_EQUAL(game.historyPosition(), path.size());
+    BOOST_CHECK_EQUAL(game.boxesOnGoals(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(Profiler_Builds_Histograms) {
+    SB::Profiler& profiler = SB::Profiler::instance();
+    std::size_t timer = profiler.probe("test_timer");
+    BOOST_CHECK_EQUAL(profiler.probe("test_timer"), timer);
+    std::size_t counter = profiler.probe("test_counter");
+    for (uint64_t ns = 1; ns <= 100; ++ns) {
+        profiler.record(timer, ns * 1000);
+    }
+    profiler.count(counter, 3);
+
+    SB::ProbeStats stats;
+    for (const SB::ProbeStats& s : profiler.snapshot()) {
+        if (s.name == "test_timer") stats = s;
+    }
+    BOOST_CHECK_EQUAL(stats.calls, 100u);
+    BOOST_CHECK_EQUAL(stats.maxNs, 100000u);
+    // 50us falls in the bucket that ends at 2^16 ns
+    BOOST_CHECK_EQUAL(stats.percentileNs(0.5), 65536u);
+    BOOST_CHECK_EQUAL(stats.percentileNs(0.99), 131072u);
+
+    std::ostringstream json;
+    profiler.writeJson(json);
+    BOOST_CHECK(json.str().find("\"test_counter\", \"calls\": 3}")
+        != std::string::npos);
+    profiler.clear();
+    BOOST_CHECK_EQUAL(profiler.snapshot()[timer].calls, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(Generator_Is_Deterministic_And_Solvable) {
+    SB::GeneratorOptions options;
+    options.width = 8;
+    options.height = 8;
+    options.boxes = 2;
+    options.pulls = 12;
+    options.seed = 99;
+    options.threads = 3;
+    std::vector<SB::GeneratedLevel> levels = SB::generateLevels(options, 6);
+    options.threads = 1;
+    std::vector<SB::GeneratedLevel> again = SB::generateLevels(options, 6);
+    BOOST_REQUIRE_EQUAL(levels.size(), 6u);
+
+    for (std::size_t i = 0; i < levels.size(); ++i) {
+        std::string text = SB::formatLevel(levels[i].level);
+        BOOST_CHECK_EQUAL(text, SB::formatLevel(again[i].level));
+        BOOST_CHECK_EQUAL(text, SB::formatLevel(
+            SB::generateLevel(options, levels[i].seed).level));
+
+        // The text reads back as the same level, with nothing solved yet
+        SB::ParseResult parsed = SB::parseLevels(text);
+        BOOST_REQUIRE(parsed.ok());
+        SB::GameState game(parsed.levels.front());
+        BOOST_CHECK_EQUAL(game.boxes().size(), 2u);
+        BOOST_CHECK_EQUAL(game.goalCount(), 2u);
+        BOOST_CHECK_EQUAL(game.boxesOnGoals(), 0u);
+
+        SB::SolveResult result = SB::Solver(game).solve();
+        BOOST_CHECK(result.solved);
+        BOOST_CHECK_LE(result.pushes, levels[i].pulls);
+    }
+    options.boxes = 40;
+    BOOST_CHECK_THROW(SB::generateLevel(options, 1), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(Redraws_Only_When_Something_Changed) {
+    SB::Sokoban s("level1.lvl");
+    sf::RenderTexture target;
+    target.create(640, 640);
+    BOOST_CHECK(s.needsRedraw());
+    target.draw(s);
+    BOOST_CHECK(!s.needsRedraw());
+    BOOST_CHECK(s.untilRedraw() > sf::Time::Zero);
+    BOOST_CHECK(s.untilRedraw() <= sf::seconds(1.f));
+
+    s.movePlayer(SB::Direction::Up);
+    BOOST_CHECK(s.needsRedraw());
+    BOOST_CHECK(s.untilRedraw() == sf::Time::Zero);
+    target.draw(s);
+    BOOST_CHECK(!s.needsRedraw());
+
+    // A step repaints the two squares the player left and entered
+    SB::BoardRenderer renderer(SB::Sokoban::TILE_SIZE);
+    renderer.build(s.getBoard(), s.getBoxes(), s.playerLoc());
+    target.draw(renderer);
+    BOOST_CHECK_EQUAL(renderer.pendingTiles(), 0u);
+    renderer.placePlayer({3, 4});
+    BOOST_CHECK_EQUAL(renderer.pendingTiles(), 2u);
+    // Pacing between two squares without drawing lists each square once
+    for (int i = 0; i < 100; ++i) {
+        renderer.placePlayer(i % 2 ? sf::Vector2u(3, 4)
+            : s.playerLoc());
+    }
+    BOOST_CHECK_EQUAL(renderer.pendingTiles(), 2u);
+    target.draw(renderer);
+    BOOST_CHECK_EQUAL(renderer.pendingTiles(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(Idle_Wait_Backs_Off_Between_Polls) {
+    // 200ms without input: naps of 1, 2, 4, 8 and then 16ms, not 50
+    // polls of 4ms
+    sf::RenderWindow window(sf::VideoMode(64, 64), "idle");
+    SB::RenderScheduler scheduler;
+    sf::Event event;
+    BOOST_CHECK(!scheduler.waitEvent(window, event, sf::milliseconds(200)));
+    BOOST_CHECK(scheduler.wakeups() <= 4 + 200 / 16 + 1);
+}
+
+BOOST_AUTO_TEST_CASE(Camera_Draws_Only_What_The_Window_Shows) {
+    // 400 squares of 64 pixels is too wide for the canvas
+    const unsigned int ts = SB::Sokoban::TILE_SIZE;
+    SB::Board big(400, 400);
+    std::vector<sf::Vector2u> boxes = {{200, 199}, {5, 5}};
+    SB::BoardRenderer renderer(ts);
+    renderer.build(big, boxes, {200, 200});
+
+    SB::Camera camera(ts);
+    camera.reset({400, 400}, {640, 480});
+    BOOST_CHECK_EQUAL(camera.zoom(), 1.f);
+    BOOST_CHECK(!camera.follow({200, 200}));  // already in the middle
+    BOOST_CHECK(camera.follow({210, 200}));
+    sf::IntRect seen = renderer.visibleTiles(camera.view());
+    BOOST_CHECK(seen.contains(214, 200));
+    BOOST_CHECK_EQUAL(seen.width * seen.height, 10 * 8);
+    camera.follow({200, 200});
+
+    // At most four chunks and the two pieces near the player, not the
+    // 160000 squares of the board
+    sf::RenderTexture target;
+    target.create(640, 480);
+    target.setView(camera.view());
+    target.draw(renderer);
+    BOOST_CHECK_EQUAL(renderer.drawnQuads() % (32 * 32), 2u);
+    BOOST_CHECK(renderer.drawnQuads() <= 4 * 32 * 32 + 2);
+
+    // 100 squares fit one texture but not the canvas budget, so the
+    // board is drawn from chunks rather than a 6400 pixel canvas
+    SB::BoardRenderer medium(ts);
+    medium.build(SB::Board(100, 100), boxes, {50, 50});
+    target.setView(sf::View({3200.f, 3200.f}, {640.f, 480.f}));
+    target.draw(medium);
+    BOOST_CHECK(medium.drawnQuads() > 1);
+
+    // Zooming out is capped, so the view stays a bounded size
+    for (int i = 0; i < 50; ++i) camera.zoomBy(0.5f);
+    seen = renderer.visibleTiles(camera.view());
+    BOOST_CHECK(seen.width <= static_cast<int>(SB::Camera::MaxVisibleTiles)
+        + 1);
+    BOOST_CHECK(!camera.zoomBy(0.5f));
+    // The edge of the level stops the scrolling
+    camera.reset({400, 400}, {640, 480});
+    camera.follow({0, 0});
+    seen = renderer.visibleTiles(camera.view());
+    BOOST_CHECK_EQUAL(seen.left, 0);
+    BOOST_CHECK_EQUAL(seen.top, 0);
+}
+
+BOOST_AUTO_TEST_CASE(Batch_Matches_GameState_Step_For_Step) {
+    SB::ParseResult parsed = SB::readLevels("level1.lvl");
+    BOOST_REQUIRE(parsed.ok());
+    const SB::Board& level = parsed.levels.front();
+    const std::size_t count = 64;
+    SB::BatchSim batch(level, count);
+    std::vector<SB::GameState> games(count, SB::GameState(level));
+    std::mt19937 rng(7);
+    std::vector<uint8_t> dirs(count);
+    for (int t = 0; t < 200; ++t) {
+        std::size_t expected = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            dirs[i] = static_cast<uint8_t>(rng() % 5);  // 4 is Stay
+            if (dirs[i] != SB::BatchSim::Stay) {
+                auto dir = static_cast<SB::Direction>(dirs[i]);
+                expected += games[i].move(dir);
+            }
+        }
+        BOOST_CHECK_EQUAL(batch.step(dirs), expected);
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+        BOOST_CHECK_EQUAL(batch.player(i), games[i].player());
+        BOOST_CHECK_EQUAL(batch.moves(i), games[i].moves());
+        BOOST_CHECK_EQUAL(batch.boxesOnGoals(i), games[i].boxesOnGoals());
+        BOOST_CHECK(SB::formatLevel(batch.board(i))
+            == SB::formatLevel(games[i].board()));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(Playouts_Score_Sequences_In_Order) {
+    SB::ParseResult parsed = SB::readLevels("level4.lvl");
+    BOOST_REQUIRE(parsed.ok());
+    SB::GameState start(parsed.levels.front());
+    SB::SolveResult solution = SB::Solver(start).solve();
+    BOOST_REQUIRE(solution.solved);
+
+    // The solution with junk after it, cut short, and a wall bump
+    std::vector<std::vector<SB::Direction>> sequences(300);
+    for (std::size_t i = 0; i < sequences.size(); ++i) {
+        sequences[i] = solution.moves;
+        if (i % 3 == 1) sequences[i].resize(sequences[i].size() / 2);
+        if (i % 3 == 2) sequences[i].push_back(SB::Direction::Up);
+    }
+    std::vector<SB::PlayoutResult> one =
+        SB::runPlayouts(start.board(), sequences, 1, 64);
+    std::vector<SB::PlayoutResult> many =
+        SB::runPlayouts(start.board(), sequences, 4, 7);
+    // The level fits a FixedBoard, BatchSim has to be asked for
+    BOOST_REQUIRE((SB::FixedBoard<16, 16>::fits(start.board())));
+    std::vector<SB::PlayoutResult> batched = SB::runPlayouts(start.board(),
+        sequences, 2, 32, SB::PlayoutKernel::Batch);
+    BOOST_REQUIRE_EQUAL(one.size(), sequences.size());
+    BOOST_REQUIRE_EQUAL(batched.size(), sequences.size());
+    for (std::size_t i = 0; i < sequences.size(); ++i) {
+        BOOST_CHECK_EQUAL(one[i].won, i % 3 != 1);
+        BOOST_CHECK_EQUAL(one[i].length, i % 3 == 1
+            ? solution.moves.size() / 2 : solution.moves.size());
+        if (one[i].won) {
+            BOOST_CHECK_EQUAL(one[i].pushes, solution.pushes);
+        }
+        BOOST_CHECK_EQUAL(one[i].moves, many[i].moves);
+        BOOST_CHECK_EQUAL(one[i].won, many[i].won);
+        BOOST_CHECK_EQUAL(batched[i].won, one[i].won);
+        BOOST_CHECK_EQUAL(batched[i].lost, one[i].lost);
+        BOOST_CHECK_EQUAL(batched[i].length, one[i].length);
+        BOOST_CHECK_EQUAL(batched[i].moves, one[i].moves);
+        BOOST_CHECK_EQUAL(batched[i].pushes, one[i].pushes);
+        BOOST_CHECK_EQUAL(batched[i].blocked, one[i].blocked);
+        BOOST_CHECK_EQUAL(batched[i].boxesOnGoals, one[i].boxesOnGoals);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(Fixed_Board_Matches_GameState) {
+    SB::ParseResult parsed = SB::readLevels("level1.lvl");
+    BOOST_REQUIRE(parsed.ok());
+    const SB::Board& level = parsed.levels.front();
+    using Small = SB::FixedBoard<8, 8>;
+    using Fixed = SB::FixedBoard<16, 16>;
+    BOOST_CHECK(!Small::fits(level));
+    BOOST_REQUIRE(Fixed::fits(level));
+    Fixed fixed(level);
+    SB::GameState game(level);
+
+    // Same walkable region as the path planner, found by shifting masks
+    BOOST_CHECK_EQUAL(fixed.reachable().count(), 58u);
+    BOOST_CHECK(!fixed.reachable().test(Fixed::square(4, 4)));
+
+    std::mt19937 rng(11);
+    for (int t = 0; t < 500; ++t) {
+        auto dir = static_cast<SB::Direction>(rng() % 4);
+        BOOST_CHECK_EQUAL(fixed.move(dir), game.move(dir));
+    }
+    BOOST_CHECK_EQUAL(fixed.moves(), game.moves());
+    BOOST_CHECK_EQUAL(fixed.boxesOnGoals(), game.boxesOnGoals());
+    for (unsigned int y = 0; y < level.height(); ++y) {
+        for (unsigned int x = 0; x < level.width(); ++x) {
+            std::size_t i = level.index(x, y);
+            BOOST_CHECK_EQUAL(fixed.boxes().test(Fixed::square(x, y)),
+                game.board().hasBox(i));
+            BOOST_CHECK_EQUAL(fixed.player() == Fixed::square(x, y),
+                game.player() == i);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(Solution_Cache_Survives_Reopening) {
+    std::remove("test_cache.bin");
+    SB::ParseResult one = SB::readLevels("level1.lvl");
+    SB::ParseResult two = SB::readLevels("level2.lvl");
+    BOOST_REQUIRE(one.ok() && two.ok());
+    const SB::Board& level = one.levels.front();
+    uint64_t key = SB::levelKey(level);
+    BOOST_CHECK_EQUAL(key, SB::levelKey(SB::Board(level)));
+    BOOST_CHECK(key != SB::levelKey(two.levels.front()));
+    {
+        SB::SolutionCache cache("test_cache.bin");
+        BOOST_CHECK(!cache.find(key));
+        SB::CacheEntry slow;
+        slow.key = key;
+        slow.solution = "uduuurrUdrddDldRR";
+        slow.wins = 1;
+        slow.bestSeconds = 30.5;
+        cache.record(level, slow);
+        SB::CacheEntry fast = slow;
+        fast.solution = "uuurrUdrddDldRR";
+        fast.moves = 1;  // taken from the replay, not the caller
+        fast.bestSeconds = 42;
+        cache.record(level, fast);
+        // Only solutions that play out are kept
+        SB::CacheEntry wrong = slow;
+        wrong.solution = "uuurrUdrdd";
+        BOOST_CHECK_THROW(cache.record(level, wrong), std::invalid_argument);
+        wrong.solution = "rRR";
+        BOOST_CHECK_THROW(cache.record(level, wrong), std::invalid_argument);
+        wrong.solution.clear();
+        wrong.status = SB::CacheEntry::Solved;
+        BOOST_CHECK_THROW(cache.record(level, wrong), std::invalid_argument);
+        BOOST_CHECK_THROW(cache.record(two.levels.front(), fast),
+            std::invalid_argument);
+    }
+    // A torn record at the end is dropped and written over
+    {
+        std::ofstream torn("test_cache.bin", std::ios::binary
+            | std::ios::app);
+        torn << "\x40\x00\x00";
+    }
+    SB::SolutionCache cache("test_cache.bin");
+    std::optional<SB::CacheEntry> known = cache.find(key);
+    BOOST_REQUIRE(known);
+    BOOST_CHECK_EQUAL(known->solution, "uuurrUdrddDldRR");
+    BOOST_CHECK_EQUAL(known->moves, 15u);
+    BOOST_CHECK_EQUAL(known->pushes, 4u);
+    BOOST_CHECK_EQUAL(known->wins, 2u);
+    BOOST_CHECK_CLOSE(known->bestSeconds, 30.5, 0.01);
+    BOOST_CHECK(known->status == SB::CacheEntry::Solved);
+    BOOST_CHECK_EQUAL(cache.superseded(), 1u);
+    SB::CacheEntry other;
+    other.key = SB::levelKey(two.levels.front());
+    other.status = SB::CacheEntry::OutOfBudget;
+    other.budget = 10;
+    cache.record(two.levels.front(), other);
+    other.budget = 20;
+    cache.record(two.levels.front(), other);
+    BOOST_CHECK_EQUAL(cache.superseded(), 2u);
+    cache.compact();
+    BOOST_CHECK_EQUAL(cache.superseded(), 0u);
+    SB::SolutionCache reopened("test_cache.bin");
+    BOOST_CHECK_EQUAL(reopened.size(), 2u);
+    BOOST_CHECK_EQUAL(reopened.superseded(), 0u);
+    BOOST_CHECK_EQUAL(reopened.find(other.key)->budget, 20u);
+    std::remove("test_cache.bin");
+}
+
+BOOST_AUTO_TEST_CASE(Solution_Cache_Leaves_Foreign_Files_Alone) {
+    const std::string foreign = "not a cache, but somebody's notes\n";
+    {
+        std::ofstream out("test_foreign.bin", std::ios::binary);
+        out << foreign;
+    }
+    SB::ParseResult one = SB::readLevels("level1.lvl");
+    BOOST_REQUIRE(one.ok());
+    SB::CacheEntry entry;
+    entry.key = SB::levelKey(one.levels.front());
+    entry.solution = "uuurrUdrddDldRR";
+    SB::SolutionCache cache("test_foreign.bin");
+    BOOST_CHECK_THROW(cache.find(entry.key), std::runtime_error);
+    BOOST_CHECK_THROW(cache.record(one.levels.front(), entry),
+        std::runtime_error);
+    BOOST_CHECK_THROW(cache.compact(), std::runtime_error);
+    std::ifstream in("test_foreign.bin", std::ios::binary);
+    std::string bytes((std::istreambuf_iterator<char>(in)),
+        std::istreambuf_iterator<char>());
+    BOOST_CHECK_EQUAL(bytes, foreign);
+    in.close();
+    std::remove("test_foreign.bin");
+}
+
+BOOST_AUTO_TEST_CASE(Verifier_Skips_Cached_Levels) {
+    std::remove("test_verify.cache");
+    SB::SolutionCache cache("test_verify.cache");
+    SB::VerifyOptions options;
+    options.threads = 2;
+    options.cache = &cache;
+    SB::VerifyReport first = SB::verify({"level1.lvl", "level4.lvl"},
+        options);
+    BOOST_CHECK_EQUAL(first.cached(), 0u);
+    SB::VerifyReport second = SB::verify({"level1.lvl", "level4.lvl"},
+        options);
+    BOOST_REQUIRE_EQUAL(second.levels.size(), first.levels.size());
+    BOOST_CHECK_EQUAL(second.cached(), second.levels.size());
+    for (std::size_t i = 0; i < first.levels.size(); ++i) {
+        BOOST_CHECK(second.levels[i].status == first.levels[i].status);
+        BOOST_CHECK_EQUAL(second.levels[i].moves, first.levels[i].moves);
+    }
+    std::remove("test_verify.cache");
+
+    // A cache that cannot be read marks each level invalid, the run goes on
+    {
+        std::ofstream bad("test_verify.cache", std::ios::binary);
+        bad << "garbage";
+    }
+    SB::SolutionCache broken("test_verify.cache");
+    options.cache = &broken;
+    SB::VerifyReport third;
+    BOOST_REQUIRE_NO_THROW(third = SB::verify({"level1.lvl", "level4.lvl"},
+        options));
+    BOOST_CHECK_EQUAL(third.levels.size(), first.levels.size());
+    BOOST_CHECK_EQUAL(third.count(SB::LevelReport::Invalid),
+        third.levels.size());
+    std::remove("test_verify.cache");
+}
+
+BOOST_AUTO_TEST_CASE(Session_Plays_Every_Level_In_Order) {
+    SB::ParseResult one = SB::readLevels("level1.lvl");
+    SB::ParseResult two = SB::readLevels("level2.lvl");
+    SB::ParseResult four = SB::readLevels("level4.lvl");
+    BOOST_REQUIRE(one.ok() && two.ok() && four.ok());
+    SB::LevelPack::write("test_session.sbpk",
+        {two.levels.front(), four.levels.front()});
+    {
+        std::ofstream both("test_session.lvl");
+        both << SB::formatLevel(four.levels.front())
+             << SB::formatLevel(one.levels.front());
+    }
+
+    SB::Session session({"level1.lvl", "test_session.sbpk",
+        "test_session.lvl"});
+    BOOST_REQUIRE_EQUAL(session.size(), 5u);
+    BOOST_CHECK_EQUAL(session.source(3), "test_session.lvl");
+    const SB::Board* expected[] = {&one.levels.front(), &two.levels.front(),
+        &four.levels.front(), &four.levels.front(), &one.levels.front()};
+    BOOST_CHECK_EQUAL(SB::formatLevel(session.load(0).board()),
+        SB::formatLevel(*expected[0]));
+    while (session.hasNext()) {
+        SB::GameState level = session.next();
+        BOOST_CHECK_EQUAL(SB::formatLevel(level.board()),
+            SB::formatLevel(*expected[session.position()]));
+    }
+    BOOST_CHECK_EQUAL(session.position(), 4u);
+    // Jumping back skips the prefetch
+    BOOST_CHECK_EQUAL(session.load(1).boxes().size(),
+        SB::GameState(two.levels.front()).boxes().size());
+    BOOST_CHECK_THROW(session.load(5), std::out_of_range);
+    std::remove("test_session.sbpk");
+    std::remove("test_session.lvl");
+}
+
+BOOST_AUTO_TEST_CASE(Input_Queue_Paces_A_Burst_And_Times_It) {
+    using Clock = SB::InputQueue::Clock;
+    using std::chrono::milliseconds;
+    SB::InputQueue input(milliseconds(8), 1, 2);
+    Clock::time_point t0 = Clock::now();
+    std::vector<SB::Direction> played;
+    auto apply = [&](const SB::InputEvent& event) {
+        played.push_back(event.dir);
+    };
+    BOOST_CHECK(input.untilStep(t0) == Clock::duration::max());
+
+    // Five presses pile up behind a 40ms frame
+    for (int i = 0; i < 5; ++i) {
+        SB::InputEvent event;
+        event.dir = static_cast<SB::Direction>(i % 4);
+        event.at = t0 + milliseconds(i);
+        input.push(event);
+    }
+    Clock::time_point now = t0 + milliseconds(40);
+    // Two steps at most, then one per step, in the order pressed
+    BOOST_CHECK_EQUAL(input.update(now, apply), 2u);
+    BOOST_CHECK_EQUAL(input.update(now + milliseconds(4), apply), 0u);
+    BOOST_CHECK(input.untilStep(now + milliseconds(4)) == milliseconds(4));
+    BOOST_CHECK_EQUAL(input.update(now + milliseconds(8), apply), 1u);
+    BOOST_REQUIRE_EQUAL(played.size(), 3u);
+    BOOST_CHECK(played[2] == SB::Direction::Left);
+
+    BOOST_CHECK_EQUAL(input.presented(now + milliseconds(10)), 3u);
+    BOOST_CHECK_EQUAL(input.presented(now + milliseconds(20)), 0u);
+    input.update(now + milliseconds(16), apply);
+    input.unchanged();  // no frame drawn, nothing recorded
+    BOOST_CHECK_EQUAL(input.presented(now + milliseconds(30)), 0u);
+    BOOST_CHECK(input.percentile(0.5) == milliseconds(49));
+    BOOST_CHECK(input.percentile(1.0) == milliseconds(50));
+    BOOST_CHECK(!input.summary().empty());
+
+    // Nothing queued for a while: the next press goes straight through
+    input.clear();
+    SB::InputEvent late;
+    late.at = now + milliseconds(500);
+    input.push(late);
+    BOOST_CHECK_EQUAL(input.update(late.at, apply), 1u);
+}
@@ -0,0 +1,74 @@
+//  Copyright 2025 <Orbosa Igbinovia> [legal/copyright]
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "SolutionCache.hpp"
+#include "Verifier.hpp"
+
+int main(int argc, char* argv[]) {
+    SB::VerifyOptions options;
+    options.solver.maxNodes = 200000;
+    std::string reportFile;
+    std::unique_ptr<SB::SolutionCache> cache;
+    int first = 1;
+    for (; first < argc && argv[first][0] == '-'; ++first) {
+        std::string flag = argv[first];
+        if (flag == "--threads" && first + 1 < argc) {
+            options.threads = static_cast<unsigned int>(
+                std::strtoul(argv[++first], nullptr, 10));
+        } else if (flag == "--max-nodes" && first + 1 < argc) {
+            options.solver.maxNodes = std::strtoull(argv[++first], nullptr, 10);
+        } else if (flag == "--report" && first + 1 < argc) {
+            reportFile = argv[++first];
+        } else if (flag == "--cache" && first + 1 < argc) {
+            cache = std::make_unique<SB::SolutionCache>(argv[++first]);
+            options.cache = cache.get();
+        } else {
+            first = argc;
+            break;
+        }
+    }
+    if (first >= argc) {
+        std::cerr << "Usage: ./sokoban-verify [--threads N] [--max-nodes N] "
+         "[--report out.json]\n"
+         "       [--cache verify.cache] dir|pack|level...\n";
+        return 1;
+    }
+
+    SB::VerifyReport report;
+    try {
+        report = SB::verify(std::vector<std::string>(argv + first,
+            argv + argc), options);
+        // every solve appends a record, so old ones pile up across runs
+        if (cache && cache->superseded() > cache->size()) {
+            cache->compact();
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+
+    if (reportFile.empty()) {
+        SB::writeJson(std::cout, report);
+    } else {
+        std::ofstream out(reportFile);
+        SB::writeJson(out, report);
+        if (!out) {
+            std::cerr << "Unable to write file: " << reportFile << "\n";
+            return 1;
+        }
+    }
+    std::cerr << report.levels.size() << " levels on " << report.threads
+     << " threads in " << report.seconds << "s: "
+     << report.count(SB::LevelReport::Solved) << " solved, "
+     << report.count(SB::LevelReport::Unsolvable) << " unsolvable, "
+     << report.count(SB::LevelReport::OutOfBudget) << " out of budget, "
+     << report.count(SB::LevelReport::Invalid) << " invalid, "
+     << report.cached() << " from the cache\n";
+    return report.count(SB::LevelReport::Solved) == report.levels.size()
+        ? 0 : 2;
+}